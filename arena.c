@@ -0,0 +1,79 @@
+#include "arena.h"
+#include <stdalign.h>
+
+struct arena_blok {
+    ARENA_BLOK *vorige;
+    size_t size;
+    max_align_t data[];
+};
+
+#define UITLIJNING alignof(max_align_t)
+
+void arena_init(ARENA *arena, GEHEUGEN *geheugen, GEHEUGEN_SOORT soort)
+{
+    arena->geheugen = geheugen;
+    arena->soort = soort;
+    arena->blok = NULL;
+    arena->gebruikt = 0;
+    arena->volgende = ARENA_EERSTE_BLOK;
+}
+
+void* arena_alloc(ARENA *arena, size_t size)
+{
+    size = (size + UITLIJNING - 1) & ~(UITLIJNING - 1);
+
+    if (arena->blok == NULL || arena->blok->size - arena->gebruikt < size) {
+        // te groot voor een gewoon blok: dan een eigen blok precies zo groot
+        size_t blok_size = size > arena->volgende ? size : arena->volgende;
+        ARENA_BLOK *blok = geheugen_alloc(arena->geheugen, arena->soort, sizeof(ARENA_BLOK) + blok_size);
+        if (blok == NULL) {
+            return NULL;
+        }
+        blok->vorige = arena->blok;
+        blok->size = blok_size;
+        arena->blok = blok;
+        arena->gebruikt = 0;
+        if (arena->volgende < ARENA_MAX_BLOK) {
+            arena->volgende *= 2;
+        }
+    }
+
+    void *p = (char*)arena->blok->data + arena->gebruikt;
+    arena->gebruikt += size;
+    return p;
+}
+
+void arena_neem_over(ARENA *arena, ARENA *andere)
+{
+    if (andere->blok == NULL) {
+        return;
+    }
+
+    if (arena->blok == NULL) {
+        arena->blok = andere->blok;
+        arena->gebruikt = andere->gebruikt;
+    } else {
+        // achter het huidige blok, zodat er gewoon in verder gealloceerd wordt
+        ARENA_BLOK *oudste = andere->blok;
+        while (oudste->vorige != NULL) {
+            oudste = oudste->vorige;
+        }
+        oudste->vorige = arena->blok->vorige;
+        arena->blok->vorige = andere->blok;
+    }
+
+    andere->blok = NULL;
+    andere->gebruikt = 0;
+    andere->volgende = ARENA_EERSTE_BLOK;
+}
+
+void arena_vrij(ARENA *arena)
+{
+    while (arena->blok != NULL) {
+        ARENA_BLOK *vorige = arena->blok->vorige;
+        geheugen_vrij(arena->blok);
+        arena->blok = vorige;
+    }
+    arena->gebruikt = 0;
+    arena->volgende = ARENA_EERSTE_BLOK;
+}
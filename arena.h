@@ -0,0 +1,42 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "geheugen.h"
+#include <stddef.h>
+
+/*
+ * Geheugen voor veel kleine objecten die allemaal tegelijk weg kunnen, zoals
+ * de knopen van één syntaxboom. Er wordt in grote blokken gealloceerd en
+ * daarbinnen alleen een wijzer opgeschoven; losse objecten worden nooit
+ * vrijgegeven, arena_vrij geeft alles in één keer terug.
+ *
+ * Een arena is niet thread-safe; gebruik er één per thread.
+ */
+
+typedef struct arena_blok ARENA_BLOK;
+
+typedef struct {
+    // waar de blokken vandaan komen
+    GEHEUGEN *geheugen;
+    GEHEUGEN_SOORT soort;
+
+    // het nieuwste blok; elk blok wijst naar het vorige
+    ARENA_BLOK *blok;
+    size_t gebruikt;
+    // grootte van het volgende blok, groeit tot ARENA_MAX_BLOK
+    size_t volgende;
+} ARENA;
+
+#define ARENA_EERSTE_BLOK (4 * 1024)
+#define ARENA_MAX_BLOK (1024 * 1024)
+
+// geheugen NULL: geheugen_standaard
+void arena_init(ARENA *arena, GEHEUGEN *geheugen, GEHEUGEN_SOORT soort);
+// Uitgelijnd zoals malloc; alleen NULL als er geen blok meer bij kan
+void* arena_alloc(ARENA *arena, size_t size);
+// Neemt de blokken van andere over, zodat arena_vrij(arena) ze ook vrijgeeft; andere is daarna leeg
+void arena_neem_over(ARENA *arena, ARENA *andere);
+// Geeft alle blokken vrij; daarna kan de arena opnieuw gebruikt worden
+void arena_vrij(ARENA *arena);
+
+#endif
@@ -0,0 +1,441 @@
+#define _XOPEN_SOURCE 700
+#include "dienst.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Grootste verzoek (alleen de argumenten) dat de server aanneemt
+#define DIENST_MAX_VERZOEK (1 << 20)
+#define DIENST_BLOK (1 << 16)
+
+static void zet_lengte(unsigned char *p, uint32_t lengte)
+{
+    p[0] = lengte >> 24;
+    p[1] = lengte >> 16;
+    p[2] = lengte >> 8;
+    p[3] = lengte;
+}
+
+static uint32_t lees_lengte(const unsigned char *p)
+{
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+// Schrijft alles naar een socket; een gesloten verbinding is een fout, geen SIGPIPE
+static bool stuur(int fd, const void *data, size_t size)
+{
+    const char *p = data;
+    while (size > 0) {
+        ssize_t n = send(fd, p, size, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+static bool schrijf(int fd, const void *data, size_t size)
+{
+    const char *p = data;
+    while (size > 0) {
+        ssize_t n = write(fd, p, size);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+static bool lees_precies(int fd, void *data, size_t size)
+{
+    char *p = data;
+    while (size > 0) {
+        ssize_t n = read(fd, p, size);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+static bool stuur_blok(int fd, char kanaal, const void *data, uint32_t lengte)
+{
+    unsigned char kop[5];
+    kop[0] = kanaal;
+    zet_lengte(kop + 1, lengte);
+    return stuur(fd, kop, sizeof(kop)) && stuur(fd, data, lengte);
+}
+
+static bool maak_adres(const char *pad, struct sockaddr_un *adres)
+{
+    memset(adres, 0, sizeof(*adres));
+    adres->sun_family = AF_UNIX;
+    if (strlen(pad) >= sizeof(adres->sun_path)) {
+        fprintf(stderr, "Socketpad te lang: %s\n", pad);
+        return false;
+    }
+    strcpy(adres->sun_path, pad);
+    return true;
+}
+
+/*
+ * Eén verzoek, in een eigen proces: leest de argumenten, start het script in
+ * een kleinkind met de socket als stdin en twee pijpen als stdout en stderr,
+ * en stuurt wat daar uit komt in blokken terug, gevolgd door de exitstatus.
+ */
+static int dienst_verzoek(int verbinding, DIENST_PROGRAMMA programma)
+{
+    // de server ruimt zijn kinderen automatisch op, dit proces wil zelf wachten
+    signal(SIGCHLD, SIG_DFL);
+
+    unsigned char kop[4];
+    if (!lees_precies(verbinding, kop, sizeof(kop))) {
+        return 1;
+    }
+    uint32_t lengte = lees_lengte(kop);
+    if (lengte == 0 || lengte > DIENST_MAX_VERZOEK) {
+        return 1;
+    }
+    char *verzoek = malloc(lengte);
+    if (verzoek == NULL || !lees_precies(verbinding, verzoek, lengte) || verzoek[lengte - 1] != '\0') {
+        return 1;
+    }
+
+    int argc = 1;
+    for (uint32_t i = 0; i < lengte; i++) {
+        argc += verzoek[i] == '\0';
+    }
+    char **argv = malloc(sizeof(char*) * (argc + 1));
+    if (argv == NULL) {
+        return 1;
+    }
+    argv[0] = "flut";
+    argc = 1;
+    for (uint32_t i = 0; i < lengte; i += strlen(verzoek + i) + 1) {
+        argv[argc++] = verzoek + i;
+    }
+    argv[argc] = NULL;
+
+    int uitvoer[2], fouten[2];
+    if (pipe(uitvoer) != 0 || pipe(fouten) != 0) {
+        return 1;
+    }
+
+    pid_t kind = fork();
+    if (kind < 0) {
+        return 1;
+    }
+    if (kind == 0) {
+        dup2(verbinding, STDIN_FILENO);
+        dup2(uitvoer[1], STDOUT_FILENO);
+        dup2(fouten[1], STDERR_FILENO);
+        close(verbinding);
+        close(uitvoer[0]);
+        close(uitvoer[1]);
+        close(fouten[0]);
+        close(fouten[1]);
+        // exit en niet _exit: de buffer van stdout moet nog geleegd worden
+        exit(programma(argc, argv));
+    }
+    close(uitvoer[1]);
+    close(fouten[1]);
+
+    struct pollfd pijpen[2] = {
+        { uitvoer[0], POLLIN, 0 },
+        { fouten[0], POLLIN, 0 },
+    };
+    const char kanalen[2] = { DIENST_UITVOER, DIENST_FOUTEN };
+    char buf[DIENST_BLOK];
+    bool verbonden = true;
+
+    while (pijpen[0].fd >= 0 || pijpen[1].fd >= 0) {
+        if (poll(pijpen, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        for (int k = 0; k < 2; k++) {
+            if (pijpen[k].revents == 0) {
+                continue;
+            }
+            ssize_t n = read(pijpen[k].fd, buf, sizeof(buf));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                close(pijpen[k].fd);
+                pijpen[k].fd = -1;
+                continue;
+            }
+            // is de client weg, dan de rest nog wel lezen zodat het script niet blijft hangen
+            if (verbonden) {
+                verbonden = stuur_blok(verbinding, kanalen[k], buf, n);
+            }
+        }
+    }
+
+    int status;
+    while (waitpid(kind, &status, 0) < 0) {
+        if (errno != EINTR) {
+            return 1;
+        }
+    }
+    unsigned char code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    if (verbonden) {
+        stuur_blok(verbinding, DIENST_STATUS, &code, 1);
+    }
+
+    close(verbinding);
+    free(argv);
+    free(verzoek);
+    return 0;
+}
+
+int dienst_serveer(const char *pad, DIENST_PROGRAMMA programma)
+{
+    struct sockaddr_un adres;
+    if (!maak_adres(pad, &adres)) {
+        return 1;
+    }
+
+    // een socket die nog van een vorige keer bestaat mag weg, een ander bestand niet
+    struct stat info;
+    if (lstat(pad, &info) == 0 && S_ISSOCK(info.st_mode)) {
+        unlink(pad);
+    }
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0) {
+        perror("socket");
+        return 1;
+    }
+    if (bind(server, (struct sockaddr*)&adres, sizeof(adres)) != 0 || listen(server, 64) != 0) {
+        fprintf(stderr, "Kan niet luisteren op %s: %s\n", pad, strerror(errno));
+        close(server);
+        return 1;
+    }
+
+    // kinderen worden door de kernel opgeruimd, de server wacht nergens op
+    signal(SIGCHLD, SIG_IGN);
+    fprintf(stderr, "flut luistert op %s\n", pad);
+
+    for (;;) {
+        int verbinding = accept(server, NULL, NULL);
+        if (verbinding < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            perror("accept");
+            break;
+        }
+
+        fflush(stdout);
+        fflush(stderr);
+        pid_t kind = fork();
+        if (kind == 0) {
+            close(server);
+            _exit(dienst_verzoek(verbinding, programma));
+        }
+        if (kind < 0) {
+            perror("fork");
+        }
+        close(verbinding);
+    }
+
+    close(server);
+    unlink(pad);
+    return 1;
+}
+
+static int verbind(const char *pad)
+{
+    struct sockaddr_un adres;
+    if (!maak_adres(pad, &adres)) {
+        return -1;
+    }
+
+    int verbinding = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (verbinding < 0) {
+        perror("socket");
+        return -1;
+    }
+    if (connect(verbinding, (struct sockaddr*)&adres, sizeof(adres)) != 0) {
+        fprintf(stderr, "Kan niet verbinden met %s: %s\n", pad, strerror(errno));
+        close(verbinding);
+        return -1;
+    }
+    return verbinding;
+}
+
+int dienst_client(const char *pad, int argc, char *argv[])
+{
+    int verbinding = verbind(pad);
+    if (verbinding < 0) {
+        return 1;
+    }
+
+    /*
+     * De server opent het bestand zelf, vanuit zijn eigen map, dus een pad
+     * wordt eerst absoluut gemaakt. Bij "-" stuurt de client daarna zijn
+     * stdin door.
+     */
+    unsigned char *verzoek = malloc(4);
+    size_t verzoek_size = 4;
+    bool invoer = false;
+    for (int i = 0; i < argc; i++) {
+        const char *argument = argv[i];
+        char *volledig = NULL;
+        if (strcmp(argument, "-") == 0) {
+            invoer = true;
+        } else if (strncmp(argument, "--", 2) != 0 && (volledig = realpath(argument, NULL)) != NULL) {
+            argument = volledig;
+        }
+
+        size_t n = strlen(argument) + 1;
+        verzoek = realloc(verzoek, verzoek_size + n);
+        memcpy(verzoek + verzoek_size, argument, n);
+        verzoek_size += n;
+        free(volledig);
+    }
+    zet_lengte(verzoek, verzoek_size - 4);
+
+    bool gestuurd = stuur(verbinding, verzoek, verzoek_size);
+    free(verzoek);
+    if (!gestuurd) {
+        fprintf(stderr, "Kan verzoek niet sturen: %s\n", strerror(errno));
+        close(verbinding);
+        return 1;
+    }
+    if (!invoer) {
+        shutdown(verbinding, SHUT_WR);
+    }
+
+    /*
+     * Invoer sturen en uitvoer lezen gebeurt door elkaar: een script dat veel
+     * print terwijl het nog invoer leest mag niet vastlopen doordat beide
+     * kanten op elkaar wachten.
+     */
+    fcntl(verbinding, F_SETFL, fcntl(verbinding, F_GETFL) | O_NONBLOCK);
+
+    char in[DIENST_BLOK];
+    size_t in_begin = 0, in_size = 0;
+    unsigned char *ontvangen = malloc(DIENST_BLOK);
+    size_t ontvangen_size = 0, ontvangen_allocated = DIENST_BLOK;
+    int status = -1;
+
+    for (;;) {
+        struct pollfd p[2] = {
+            { verbinding, POLLIN | (in_begin < in_size ? POLLOUT : 0), 0 },
+            { invoer && in_begin == in_size ? STDIN_FILENO : -1, POLLIN, 0 },
+        };
+        if (poll(p, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            perror("poll");
+            break;
+        }
+
+        if (p[1].revents != 0) {
+            ssize_t n = read(STDIN_FILENO, in, sizeof(in));
+            if (n > 0) {
+                in_begin = 0;
+                in_size = n;
+            } else if (n == 0 || errno != EINTR) {
+                invoer = false;
+                shutdown(verbinding, SHUT_WR);
+            }
+        }
+
+        if (p[0].revents & POLLOUT) {
+            ssize_t n = send(verbinding, in + in_begin, in_size - in_begin, MSG_NOSIGNAL);
+            if (n > 0) {
+                in_begin += n;
+            } else if (n < 0 && errno != EAGAIN && errno != EINTR) {
+                // het script leest niet meer; de rest van de invoer is niet nodig
+                invoer = false;
+                in_begin = in_size;
+            }
+        }
+
+        if (p[0].revents & (POLLIN | POLLHUP | POLLERR)) {
+            if (ontvangen_size == ontvangen_allocated) {
+                ontvangen_allocated *= 2;
+                ontvangen = realloc(ontvangen, ontvangen_allocated);
+            }
+            ssize_t n = recv(verbinding, ontvangen + ontvangen_size, ontvangen_allocated - ontvangen_size, 0);
+            if (n == 0) {
+                break;
+            }
+            if (n < 0) {
+                if (errno == EAGAIN || errno == EINTR) {
+                    continue;
+                }
+                perror("recv");
+                break;
+            }
+            ontvangen_size += n;
+
+            size_t i = 0;
+            while (ontvangen_size - i >= 5) {
+                uint32_t lengte = lees_lengte(ontvangen + i + 1);
+                if (ontvangen_size - i - 5 < lengte) {
+                    break;
+                }
+                const unsigned char *data = ontvangen + i + 5;
+                switch (ontvangen[i]) {
+                    case DIENST_UITVOER:
+                        schrijf(STDOUT_FILENO, data, lengte);
+                        break;
+                    case DIENST_FOUTEN:
+                        schrijf(STDERR_FILENO, data, lengte);
+                        break;
+                    case DIENST_STATUS:
+                        if (lengte == 1) {
+                            status = data[0];
+                        }
+                        break;
+                }
+                i += 5 + lengte;
+            }
+            memmove(ontvangen, ontvangen + i, ontvangen_size - i);
+            ontvangen_size -= i;
+        }
+    }
+
+    free(ontvangen);
+    close(verbinding);
+
+    if (status < 0) {
+        fprintf(stderr, "Verbinding met de server verbroken zonder exitstatus\n");
+        return 1;
+    }
+    return status;
+}
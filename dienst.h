@@ -0,0 +1,34 @@
+#ifndef DIENST_H
+#define DIENST_H
+
+/*
+ * flut als dienst: één proces blijft draaien op een Unix-socket, met de
+ * tabellen van de parser en de interntabel al opgebouwd. Per verbinding
+ * voert het één script uit in een eigen kindproces (fork), zodat elk verzoek
+ * met een schone interpreter begint maar niets opnieuw hoeft op te warmen.
+ *
+ * Verzoek, van client naar server: vier bytes lengte (big-endian), dan de
+ * argumenten zoals op de opdrachtregel, elk afgesloten met een nul-byte. Is
+ * het bestand "-", dan volgt daarna het script zelf, tot de client zijn
+ * schrijfkant sluit. Een pad wordt door de server geopend, dus de client
+ * stuurt een absoluut pad.
+ *
+ * Antwoord: blokken van één byte kanaal, vier bytes lengte (big-endian) en
+ * de data. Kanaal DIENST_UITVOER en DIENST_FOUTEN zijn stdout en stderr van
+ * het script; het laatste blok is DIENST_STATUS met één byte exitstatus
+ * (128 + signaal als het script gecrasht is).
+ */
+
+#define DIENST_UITVOER '1'
+#define DIENST_FOUTEN  '2'
+#define DIENST_STATUS  'S'
+
+// Voert één script uit zoals main met deze argumenten; geeft de exitstatus terug
+typedef int (*DIENST_PROGRAMMA)(int argc, char *argv[]);
+
+// Luistert op pad en voert elk verzoek uit met programma; komt alleen terug bij een fout
+int dienst_serveer(const char *pad, DIENST_PROGRAMMA programma);
+// Stuurt argv naar de server op pad, geeft de uitvoer door en geeft de exitstatus terug
+int dienst_client(const char *pad, int argc, char *argv[]);
+
+#endif
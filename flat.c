@@ -0,0 +1,157 @@
+#include "flat.h"
+#include <string.h>
+
+typedef struct {
+    FLAT_TREE *tree;
+    uint32_t next_node;
+    uint32_t next_statement;
+} FLAT_BUILDER;
+
+static void count_body(const PARSER_NODE_BODY *body, uint32_t *nodes, uint32_t *statements);
+
+static void count_node(const PARSER_NODE *node, uint32_t *nodes, uint32_t *statements)
+{
+    if (node == NULL) {
+        return;
+    }
+
+    *nodes += 1;
+    if (node->type == PARSER_TYPE_BODY) {
+        count_body(&node->body, nodes, statements);
+    } else if (node->type == PARSER_TYPE_CONDITIONAL) {
+        count_node(node->expression, nodes, statements);
+    }
+    count_node(node->left, nodes, statements);
+    count_node(node->right, nodes, statements);
+}
+
+static void count_body(const PARSER_NODE_BODY *body, uint32_t *nodes, uint32_t *statements)
+{
+    *statements += body->expressions_size;
+    for (size_t i = 0; i < body->expressions_size; i++) {
+        count_node(body->expressions[i], nodes, statements);
+    }
+}
+
+// Points the arrays into the block; the 32-bit arrays come first so everything stays aligned
+static void attach(FLAT_TREE *tree)
+{
+    uint32_t *words = tree->block;
+    tree->value = words;
+    tree->left = words + tree->size;
+    tree->right = words + 2 * (size_t)tree->size;
+    tree->statements = words + 3 * (size_t)tree->size;
+
+    uint8_t *bytes = (uint8_t*)(tree->statements + tree->statements_size);
+    tree->type = bytes;
+    tree->kind = bytes + tree->size;
+}
+
+static void allocate(FLAT_TREE *tree, uint32_t size, uint32_t statements_size, GEHEUGEN *geheugen)
+{
+    tree->size = size;
+    tree->statements_size = statements_size;
+    tree->block_size = sizeof(uint32_t) * (3 * (size_t)size + statements_size) + 2 * (size_t)size;
+    tree->block = geheugen_alloc(geheugen, GEHEUGEN_BOOM, tree->block_size);
+    attach(tree);
+}
+
+static uint32_t add_body(FLAT_BUILDER *b, const PARSER_NODE_BODY *body);
+
+static uint32_t add_node(FLAT_BUILDER *b, const PARSER_NODE *node)
+{
+    if (node == NULL) {
+        return FLAT_NONE;
+    }
+
+    uint8_t kind = 0;
+    uint32_t value = 0;
+    uint32_t left = FLAT_NONE;
+    uint32_t right = FLAT_NONE;
+
+    switch (node->type) {
+        case PARSER_TYPE_BODY:
+            value = b->next_statement;
+            right = node->body.expressions_size;
+            b->next_statement += node->body.expressions_size;
+            for (size_t i = 0; i < node->body.expressions_size; i++) {
+                b->tree->statements[value + i] = add_node(b, node->body.expressions[i]);
+            }
+            break;
+        case PARSER_TYPE_CONDITIONAL:
+            value = add_node(b, node->expression);
+            right = add_node(b, node->right);
+            left = add_node(b, node->left);
+            break;
+        case PARSER_TYPE_LITERAL:
+            kind = node->literal;
+            switch (node->literal) {
+                case PARSER_LITERAL_NUMBER:
+                    value = node->number;
+                    break;
+                case PARSER_LITERAL_STRING:
+                    value = node->string;
+                    break;
+                case PARSER_LITERAL_BOOLEAN:
+                    value = node->boolean;
+                    break;
+            }
+            break;
+        case PARSER_TYPE_IDENTIFIER:
+            value = node->identifier;
+            break;
+        default:
+            if (node->type == PARSER_TYPE_OPERATOR) {
+                kind = node->operator;
+            }
+            left = add_node(b, node->left);
+            right = add_node(b, node->right);
+            break;
+    }
+
+    uint32_t index = b->next_node++;
+    b->tree->type[index] = node->type;
+    b->tree->kind[index] = kind;
+    b->tree->value[index] = value;
+    b->tree->left[index] = left;
+    b->tree->right[index] = right;
+    return index;
+}
+
+static uint32_t add_body(FLAT_BUILDER *b, const PARSER_NODE_BODY *body)
+{
+    // the same as a PARSER_TYPE_BODY node around it
+    PARSER_NODE root = {
+        .type = PARSER_TYPE_BODY,
+        .body = *body,
+    };
+    return add_node(b, &root);
+}
+
+void flat_build(FLAT_TREE *tree, const PARSER_NODE_BODY *body, GEHEUGEN *geheugen)
+{
+    uint32_t nodes = 1;
+    uint32_t statements = 0;
+    count_body(body, &nodes, &statements);
+    allocate(tree, nodes, statements, geheugen);
+
+    FLAT_BUILDER b = {
+        .tree = tree,
+    };
+    tree->root = add_body(&b, body);
+}
+
+void flat_copy(FLAT_TREE *copy, const FLAT_TREE *tree, GEHEUGEN *geheugen)
+{
+    allocate(copy, tree->size, tree->statements_size, geheugen);
+    memcpy(copy->block, tree->block, tree->block_size);
+    copy->root = tree->root;
+}
+
+void flat_free(FLAT_TREE *tree)
+{
+    geheugen_vrij(tree->block);
+    tree->block = NULL;
+    tree->size = 0;
+    tree->statements_size = 0;
+}
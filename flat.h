@@ -0,0 +1,50 @@
+#ifndef FLAT_H
+#define FLAT_H
+#include <stddef.h>
+#include <stdint.h>
+#include "geheugen.h"
+#include "parser.h"
+
+/*
+ * The syntax tree as a struct of arrays: node i is type[i], kind[i],
+ * value[i], left[i] and right[i], and children are 32-bit indices instead of
+ * pointers. Nodes are stored in evaluation order, every child before its
+ * parent, so executing a statement walks forward through memory.
+ *
+ * All arrays live in one block without pointers inside it; copying the block
+ * copies the tree.
+ */
+
+#define FLAT_NONE UINT32_MAX
+
+typedef struct {
+    void *block;
+    size_t block_size;
+
+    uint32_t size;
+    // PARSER_TYPE
+    uint8_t *type;
+    // PARSER_LITERAL of a literal, PARSER_OPERATOR of an operator
+    uint8_t *kind;
+    // number, boolean or atom of a literal or identifier; the condition of a
+    // conditional; the first entry in statements of a body
+    uint32_t *value;
+    uint32_t *left;
+    // the number of statements of a body
+    uint32_t *right;
+
+    // statements of all bodies, each body's statements next to each other
+    uint32_t statements_size;
+    uint32_t *statements;
+
+    // the body of the whole program, always the last node
+    uint32_t root;
+} FLAT_TREE;
+
+// The block comes from geheugen (NULL: geheugen_standaard); body is not changed
+void flat_build(FLAT_TREE *tree, const PARSER_NODE_BODY *body, GEHEUGEN *geheugen);
+// One allocation and one memcpy
+void flat_copy(FLAT_TREE *copy, const FLAT_TREE *tree, GEHEUGEN *geheugen);
+void flat_free(FLAT_TREE *tree);
+
+#endif
@@ -1,8 +1,19 @@
+#define _POSIX_C_SOURCE 200809L
+#include "dienst.h"
+#include "geheugen.h"
 #include "lexer.h"
+#include "optimizer.h"
 #include "parser.h"
+#include "statistiek.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #ifndef BYTECODE_INTERPRETER
 #include "treewalker.h"
@@ -10,57 +21,508 @@
 
 void gebruik(FILE *restrict __stream, char *exec_naam)
 {
-    fprintf(__stream, "Gebruik: %s [BESTAND]\n", exec_naam);
+    fprintf(__stream, "Gebruik: %s [OPTIES] BESTAND...\n", exec_naam);
+    fprintf(__stream, "       %s [OPTIES] --lijst LIJST\n", exec_naam);
+    fprintf(__stream, "       %s --serve SOCKET\n", exec_naam);
+    fprintf(__stream, "       %s --client SOCKET [OPTIES] BESTAND\n", exec_naam);
+    fprintf(__stream, "  BESTAND is - voor standaardinvoer; meerdere bestanden lopen tegelijk op alle processors\n");
+    fprintf(__stream, "  --lijst       lees de bestanden uit LIJST, één per regel\n");
+    fprintf(__stream, "  --utf8        invoer is UTF-8: valideren en Unicode-letters in namen toestaan\n");
+    fprintf(__stream, "  --symbolen    print de symbolen van de lexer\n");
+    fprintf(__stream, "  --boom        print de syntaxboom van de parser\n");
+    fprintf(__stream, "  --variabelen  print alle variabelen na het uitvoeren\n");
+    fprintf(__stream, "  --plat        voer uit vanaf de platte syntaxboom (flat.h)\n");
+    fprintf(__stream, "  --optimaliseer vouw constanten, vereenvoudig x + 0 en x * 1, en haal als-blokken op een constante weg\n");
+    fprintf(__stream, "  --delen       gelijke expressies zijn één knoop in de syntaxboom (hash-consing)\n");
+    fprintf(__stream, "  --stats       meet lexen, parsen en uitvoeren en print dat op stderr (--stats=json: als JSON)\n");
+    fprintf(__stream, "  --serve       blijf draaien en voer scripts uit die via SOCKET binnenkomen\n");
+    fprintf(__stream, "  --client      laat de server op SOCKET het script uitvoeren\n");
 }
 
-int main(int argc, char *argv[])
+// Uitvoer gaat in grote blokken naar stdout, niet per regel
+static char uitvoer[1 << 20];
+
+typedef struct {
+    bool utf8;
+    bool symbolen;
+    bool boom;
+    bool variabelen;
+    // uitvoeren vanaf de platte boom in plaats van de knopen van de parser
+    bool plat;
+    // gelijke expressies delen één knoop, hoe vaak komt in --stats
+    bool delen;
+    // de passen van optimizer.h tussen parsen en uitvoeren
+    bool optimaliseer;
+    // fasen meten en rapporteren op de uitvoer voor fouten, met stats_json als JSON
+    bool stats;
+    bool stats_json;
+} OPTIES;
+
+// Lext de hele stroom naar een rij symbolen uit geheugen
+static LEX_SYMBOL* lex_alles(LEX_STROOM *stream, GEHEUGEN *geheugen, size_t *symbolen_size)
+{
+    LEX_SYMBOL *symbolen = NULL;
+    size_t size = 0;
+    size_t allocated = 0;
+    for (LEX_SYMBOL symbool = lex_next(stream); symbool.type != LEX_SYM_EINDE; symbool = lex_next(stream)) {
+        if (size == allocated) {
+            allocated = allocated == 0 ? 1024 : allocated * 2;
+            symbolen = geheugen_realloc(geheugen, GEHEUGEN_SYMBOLEN, symbolen, sizeof(LEX_SYMBOL) * allocated);
+        }
+        symbolen[size++] = symbool;
+    }
+    *symbolen_size = size;
+    return symbolen;
+}
+
+// Lext, parset en voert één bestand uit; uitvoer naar uit, foutmeldingen naar fout
+static int voer_uit(const char *bestand, const OPTIES *opties, FILE *uit, FILE *fout)
 {
     FILE *f;
-    long fsize = 0;
-    char *buf;
 
-    if (argc < 2) {
-        fprintf(stderr, "Geen bestand opgegeven\n");
-        gebruik(stderr, argv[0]);
-        return 1;
+    /*
+     * Een gewoon bestand wordt in het geheugen afgebeeld en zo aan de lexer
+     * gegeven, zonder kopie. Een pijp, "-" of iets anders zonder vaste
+     * grootte wordt in blokken gelezen terwijl de parser de symbolen opvraagt.
+     */
+    LEX_STROOM stream;
+    void *kaart = NULL;
+    size_t kaart_size = 0;
+
+    if (strcmp(bestand, "-") == 0) {
+        f = stdin;
+    } else {
+        int fd = open(bestand, O_RDONLY);
+        if (fd < 0) {
+            fprintf(fout, "Kan %s niet openen\n", bestand);
+            return 1;
+        }
+
+        struct stat info;
+        if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+            kaart_size = info.st_size;
+            kaart = mmap(NULL, kaart_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (kaart == MAP_FAILED) {
+                kaart = NULL;
+            }
+        }
+
+        if (kaart != NULL) {
+            posix_madvise(kaart, kaart_size, POSIX_MADV_SEQUENTIAL);
+            close(fd);
+            f = NULL;
+        } else {
+            f = fdopen(fd, "r");
+        }
     }
 
-    f = fopen(argv[1], "r");
-    if (f == NULL) {
-        fprintf(stderr, "Kan bestand niet openen\n");
-        gebruik(stderr, argv[0]);
-        return 1;
+    // eigen allocator per bestand, zodat --stats alleen dit bestand telt
+    GEHEUGEN *geheugen = geheugen_nieuw(&geheugen_malloc, NULL);
+
+    if (kaart != NULL) {
+        lex_open_mem(&stream, kaart, kaart_size);
+    } else {
+        lex_open_bestand(&stream, f, geheugen);
     }
+    stream.debug = opties->symbolen ? uit : NULL;
+    stream.utf8 = opties->utf8;
 
-    // Grootte van bestand
-    fseek(f, 0, SEEK_END);
-    fsize = ftell(f);
-    fseek(f, 0, SEEK_SET);
+    OMGEVING omgeving;
+    omgeving_init(&omgeving, uit, geheugen);
+    omgeving.delen = opties->delen;
 
-    // Laad bestand in geheugen
-    buf = malloc(fsize);
-    fread(buf, fsize, 1, f);
-    fclose(f);
+    STATISTIEK statistiek;
+    PARSER_NODE_BODY *body;
+    size_t symbolen_size = 0;
+    OPTIMIZER_REPORT verslag = { 0 };
 
-    LEX_SYMBOL *symbols = NULL;
-    size_t symbols_size;
-    symbols = lex_parse_mem(buf, fsize, &symbols_size);
+    if (opties->stats) {
+        stat_init(&statistiek, geheugen);
+    }
 
-    lex_debug_print(symbols, symbols_size);
+    /*
+     * Een afgebeeld bestand wordt eerst helemaal gelext, zodat parser() een
+     * groot programma over alle processors kan verdelen. Met --stats ook een
+     * pijp, anders lopen lexen en parsen door elkaar en zijn ze niet apart te
+     * meten; verder gaat een pijp als stroom door de parser.
+     */
+    if (kaart != NULL || opties->stats) {
+        if (opties->stats) {
+            stat_begin(&statistiek, "lexen");
+        }
+        LEX_SYMBOL *symbolen;
+        if (kaart != NULL && kaart_size >= LEX_PARALLEL_DREMPEL && !opties->symbolen) {
+            /*
+             * Groot genoeg voor de parallelle lexer. --symbolen print met de
+             * tussenruimte erbij terwijl de stroom lext, dus dat blijft bij de
+             * stroom. Ongeldige UTF-8 eindigt op een onbekend symbool; alleen
+             * dan lext de stroom hieronder nog eens, voor de regel van de fout.
+             */
+            symbolen = lex_parse_mem(kaart, kaart_size, &symbolen_size, NULL, opties->utf8, geheugen);
+            if (!opties->utf8 || symbolen_size == 0 || symbolen[symbolen_size - 1].type != LEX_SYM_ONBEKEND) {
+                lex_open_mem(&stream, kaart, 0);
+            }
+        } else {
+            symbolen = lex_alles(&stream, geheugen, &symbolen_size);
+        }
+        if (opties->stats) {
+            stat_eind(&statistiek);
+            stat_begin(&statistiek, "parsen");
+        }
+        body = parser(&omgeving, symbolen, symbolen_size);
+        if (opties->stats) {
+            stat_eind(&statistiek);
+        }
+        geheugen_vrij(symbolen);
+    } else {
+        body = parser_stream(&omgeving, &stream);
+    }
 
-    PARSER_NODE_BODY *body = parser(symbols, symbols_size);
+    // Lees de rest, voor de uitvoer van de lexer en om fouten verderop te vinden
+    while (lex_next(&stream).type != LEX_SYM_EINDE) {
+    }
+    if (opties->symbolen) {
+        fputc('\n', uit);
+    }
+
+    lex_sluit(&stream);
+    if (kaart != NULL) {
+        munmap(kaart, kaart_size);
+    } else if (f != stdin) {
+        fclose(f);
+    }
 
-    if (body != NULL) {
-        parser_debug_print(body);
+    int status = 0;
+    if (stream.leesfout) {
+        fprintf(fout, "Fout bij het lezen van %s\n", bestand);
+        status = 1;
+    } else if (stream.ongeldig) {
+        fprintf(fout, "Ongeldige UTF-8 op regel %zu (byte %zu)\n", stream.regel, stream.geldig);
+        status = 1;
+    } else if (body == NULL) {
+        fprintf(uit, "Returned NULL\nExiting...");
+        status = 1;
     } else {
-        printf("Returned NULL\nExiting...");
+        if (opties->optimaliseer) {
+            if (opties->stats) {
+                stat_begin(&statistiek, "passen");
+            }
+            optimize(body, &verslag);
+            if (opties->stats) {
+                stat_eind(&statistiek);
+            }
+        }
+
+        if (opties->boom) {
+            parser_debug_print(uit, body);
+        }
+
+        #ifndef BYTECODE_INTERPRETER
+        // Gebruik de tree-walk interpreter
+
+        if (opties->plat) {
+            FLAT_TREE plat;
+            if (opties->stats) {
+                stat_begin(&statistiek, "plat");
+            }
+            flat_build(&plat, body, geheugen);
+            if (opties->stats) {
+                stat_eind(&statistiek);
+                stat_begin(&statistiek, "uitvoeren");
+            }
+            treewalk_flat(&omgeving, &plat);
+            if (opties->stats) {
+                stat_eind(&statistiek);
+            }
+            flat_free(&plat);
+        } else {
+            if (opties->stats) {
+                stat_begin(&statistiek, "uitvoeren");
+            }
+            treewalk(&omgeving, body);
+            if (opties->stats) {
+                stat_eind(&statistiek);
+            }
+        }
+
+        if (opties->variabelen) {
+            print_all_variables(&omgeving);
+        }
+
+        #endif
+    }
+
+    if (opties->stats) {
+        STAT_OMVANG omvang = {
+            .symbolen = symbolen_size,
+            .knopen = parser_node_count(body),
+            .delen = omgeving.delen,
+            .gedeeld = omgeving.gedeeld,
+            .passen_size = opties->optimaliseer ? OPTIMIZER_PASSES : 0,
+        };
+        for (size_t pas = 0; pas < omvang.passen_size; pas++) {
+            omvang.passen[pas].naam = optimizer_pass_name(pas);
+            omvang.passen[pas].verwijderd = verslag.removed[pas];
+        }
+        stat_print(&statistiek, fout, opties->stats_json, bestand, &omvang, geheugen);
+        stat_sluit(&statistiek);
+    }
+
+    parser_free(body);
+    omgeving_vrij(&omgeving);
+    geheugen_sluit(geheugen);
+    return status;
+}
+
+/*
+ * Meerdere bestanden: een vaste groep threads pakt steeds het volgende
+ * bestand, en de uitvoer van elk bestand wordt apart verzameld. De hoofdthread
+ * schrijft die in de volgorde van de bestanden weg zodra ze klaar zijn. Een
+ * fout in één bestand houdt de andere niet tegen.
+ */
+typedef struct {
+    const char *bestand;
+    char *uitvoer;
+    size_t uitvoer_size;
+    char *fouten;
+    size_t fouten_size;
+    int status;
+    bool klaar;
+} TAAK;
+
+typedef struct {
+    TAAK *taken;
+    size_t taken_size;
+    const OPTIES *opties;
+
+    pthread_mutex_t slot;
+    pthread_cond_t klaar;
+    // eerste taak die nog door niemand is opgepakt, onder slot
+    size_t volgende;
+} PARTIJ;
+
+static void* partij_thread(void *argument)
+{
+    PARTIJ *partij = argument;
+
+    while (true) {
+        pthread_mutex_lock(&partij->slot);
+        size_t i = partij->volgende++;
+        pthread_mutex_unlock(&partij->slot);
+        if (i >= partij->taken_size) {
+            break;
+        }
+
+        TAAK *taak = &partij->taken[i];
+        FILE *uit = open_memstream(&taak->uitvoer, &taak->uitvoer_size);
+        FILE *fout = open_memstream(&taak->fouten, &taak->fouten_size);
+        if (uit == NULL || fout == NULL) {
+            taak->status = 1;
+        } else {
+            taak->status = voer_uit(taak->bestand, partij->opties, uit, fout);
+        }
+        if (uit != NULL) {
+            fclose(uit);
+        }
+        if (fout != NULL) {
+            fclose(fout);
+        }
+
+        pthread_mutex_lock(&partij->slot);
+        taak->klaar = true;
+        pthread_cond_broadcast(&partij->klaar);
+        pthread_mutex_unlock(&partij->slot);
+    }
+
+    return NULL;
+}
+
+static int voer_partij_uit(char **bestanden, size_t bestanden_size, const OPTIES *opties)
+{
+    PARTIJ partij = {
+        .taken = calloc(bestanden_size, sizeof(TAAK)),
+        .taken_size = bestanden_size,
+        .opties = opties,
+        .volgende = 0,
+    };
+    pthread_mutex_init(&partij.slot, NULL);
+    pthread_cond_init(&partij.klaar, NULL);
+    for (size_t i = 0; i < bestanden_size; i++) {
+        partij.taken[i].bestand = bestanden[i];
+    }
+
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t threads_size = processors > 0 ? (size_t)processors : 1;
+    if (threads_size > bestanden_size) {
+        threads_size = bestanden_size;
+    }
+    pthread_t *threads = malloc(sizeof(pthread_t) * threads_size);
+    size_t gestart = 0;
+    for (size_t t = 0; t < threads_size; t++) {
+        if (pthread_create(&threads[gestart], NULL, partij_thread, &partij) == 0) {
+            gestart++;
+        }
+    }
+    if (gestart == 0) {
+        // geen threads: dan alles in deze thread
+        partij_thread(&partij);
+    }
+
+    size_t mislukt = 0;
+    for (size_t i = 0; i < bestanden_size; i++) {
+        TAAK *taak = &partij.taken[i];
+        pthread_mutex_lock(&partij.slot);
+        while (!taak->klaar) {
+            pthread_cond_wait(&partij.klaar, &partij.slot);
+        }
+        pthread_mutex_unlock(&partij.slot);
+
+        printf("==> %s <==\n", taak->bestand);
+        fwrite(taak->uitvoer, 1, taak->uitvoer_size, stdout);
+        if (taak->fouten_size > 0) {
+            fflush(stdout);
+            fprintf(stderr, "%s: ", taak->bestand);
+            fwrite(taak->fouten, 1, taak->fouten_size, stderr);
+        }
+        if (taak->status != 0) {
+            mislukt++;
+        }
+        free(taak->uitvoer);
+        free(taak->fouten);
+    }
+
+    for (size_t t = 0; t < gestart; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    free(threads);
+    free(partij.taken);
+    pthread_mutex_destroy(&partij.slot);
+    pthread_cond_destroy(&partij.klaar);
+
+    if (mislukt > 0) {
+        fflush(stdout);
+        fprintf(stderr, "%zu van %zu bestanden mislukt\n", mislukt, bestanden_size);
         return 1;
     }
+    return 0;
+}
 
-    #ifndef BYTECODE_INTERPRETER
-    // Gebruik de tree-walk interpreter
+// Voegt de niet-lege regels van de lijst toe aan bestanden
+static bool lees_lijst(const char *lijst, char ***bestanden, size_t *bestanden_size)
+{
+    FILE *f = strcmp(lijst, "-") == 0 ? stdin : fopen(lijst, "r");
+    if (f == NULL) {
+        return false;
+    }
 
-    treewalk(body);
+    char *regel = NULL;
+    size_t regel_allocated = 0;
+    ssize_t lengte;
+    while ((lengte = getline(&regel, &regel_allocated, f)) >= 0) {
+        if (lengte > 0 && regel[lengte - 1] == '\n') {
+            regel[--lengte] = '\0';
+        }
+        if (lengte == 0) {
+            continue;
+        }
+        *bestanden = realloc(*bestanden, sizeof(char*) * (*bestanden_size + 1));
+        (*bestanden)[(*bestanden_size)++] = strdup(regel);
+    }
+
+    free(regel);
+    if (f != stdin) {
+        fclose(f);
+    }
+    return true;
+}
+
+// Eén opdrachtregel uitvoeren; main roept dit direct aan, of de dienst per verzoek
+static int draai(int argc, char *argv[])
+{
+    OPTIES opties = { 0 };
+    char **bestanden = NULL;
+    size_t bestanden_size = 0;
+    bool partij = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--utf8") == 0) {
+            opties.utf8 = true;
+        } else if (strcmp(argv[i], "--symbolen") == 0) {
+            opties.symbolen = true;
+        } else if (strcmp(argv[i], "--boom") == 0) {
+            opties.boom = true;
+        } else if (strcmp(argv[i], "--variabelen") == 0) {
+            opties.variabelen = true;
+        } else if (strcmp(argv[i], "--plat") == 0) {
+            opties.plat = true;
+        } else if (strcmp(argv[i], "--optimaliseer") == 0) {
+            opties.optimaliseer = true;
+        } else if (strcmp(argv[i], "--delen") == 0) {
+            opties.delen = true;
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            opties.stats = true;
+        } else if (strcmp(argv[i], "--stats=json") == 0) {
+            opties.stats = true;
+            opties.stats_json = true;
+        } else if (strcmp(argv[i], "--lijst") == 0) {
+            if (i + 1 == argc || !lees_lijst(argv[i + 1], &bestanden, &bestanden_size)) {
+                fprintf(stderr, "Kan lijst niet lezen\n");
+                gebruik(stderr, argv[0]);
+                return 1;
+            }
+            partij = true;
+            i++;
+        } else if (strncmp(argv[i], "--", 2) == 0) {
+            fprintf(stderr, "Onbekend argument: %s\n", argv[i]);
+            gebruik(stderr, argv[0]);
+            return 1;
+        } else {
+            bestanden = realloc(bestanden, sizeof(char*) * (bestanden_size + 1));
+            bestanden[bestanden_size++] = strdup(argv[i]);
+        }
+    }
+
+    int status;
+    if (bestanden_size == 0 && !partij) {
+        fprintf(stderr, "Geen bestand opgegeven\n");
+        gebruik(stderr, argv[0]);
+        status = 1;
+    } else if (bestanden_size == 1 && !partij) {
+        status = voer_uit(bestanden[0], &opties, stdout, stderr);
+    } else {
+        status = voer_partij_uit(bestanden, bestanden_size, &opties);
+    }
+
+    for (size_t i = 0; i < bestanden_size; i++) {
+        free(bestanden[i]);
+    }
+    free(bestanden);
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    setvbuf(stdout, uitvoer, _IOFBF, sizeof(uitvoer));
+
+    if (argc >= 2 && (strcmp(argv[1], "--serve") == 0 || strcmp(argv[1], "--client") == 0)) {
+        if (argc < 3) {
+            fprintf(stderr, "Geen socket opgegeven\n");
+            gebruik(stderr, argv[0]);
+            return 1;
+        }
+        if (strcmp(argv[1], "--client") == 0) {
+            return dienst_client(argv[2], argc - 3, argv + 3);
+        }
+        if (argc > 3) {
+            fprintf(stderr, "Onbekend argument: %s\n", argv[3]);
+            gebruik(stderr, argv[0]);
+            return 1;
+        }
+
+        // tabellen nu opbouwen, dan erft elk verzoek ze al klaar
+        parser_init();
+        return dienst_serveer(argv[2], draai);
+    }
 
-    #endif
+    return draai(argc, argv);
 }
@@ -0,0 +1,205 @@
+#include "geheugen.h"
+#include <stdalign.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct geheugen {
+    const GEHEUGEN_BRON *bron;
+    void *data;
+
+    // per soort, bijgewerkt door alle threads die deze allocator gebruiken
+    _Atomic uint64_t allocaties[GEHEUGEN_SOORTEN];
+    _Atomic uint64_t bytes[GEHEUGEN_SOORTEN];
+    _Atomic uint64_t live[GEHEUGEN_SOORTEN];
+    _Atomic uint64_t piek[GEHEUGEN_SOORTEN];
+    _Atomic uint64_t live_totaal;
+    _Atomic uint64_t piek_totaal;
+};
+
+static const char *soort_namen[GEHEUGEN_SOORTEN] = {
+    "symbolen",
+    "teksten",
+    "boom",
+    "variabelen",
+    "vm",
+    "overig",
+};
+
+// Staat vóór elk blok; zo groot als de uitlijning van malloc
+typedef struct {
+    alignas(max_align_t) GEHEUGEN *geheugen;
+    // grootte << 4 | soort
+    size_t size_soort;
+} kop;
+
+_Static_assert(GEHEUGEN_SOORTEN <= 16, "soort moet in vier bits passen");
+
+static void* malloc_alloc(void *data, size_t size)
+{
+    (void)data;
+    return malloc(size);
+}
+
+static void* malloc_realloc(void *data, void *p, size_t oud, size_t nieuw)
+{
+    (void)data;
+    (void)oud;
+    return realloc(p, nieuw);
+}
+
+static void malloc_vrij(void *data, void *p, size_t size)
+{
+    (void)data;
+    (void)size;
+    free(p);
+}
+
+const GEHEUGEN_BRON geheugen_malloc = {
+    .alloc = malloc_alloc,
+    .realloc = malloc_realloc,
+    .vrij = malloc_vrij,
+};
+
+GEHEUGEN geheugen_standaard = {
+    .bron = &geheugen_malloc,
+};
+
+GEHEUGEN* geheugen_nieuw(const GEHEUGEN_BRON *bron, void *data)
+{
+    if (bron == NULL) {
+        bron = &geheugen_malloc;
+    }
+    GEHEUGEN *geheugen = bron->alloc(data, sizeof(GEHEUGEN));
+    if (geheugen == NULL) {
+        return NULL;
+    }
+    geheugen->bron = bron;
+    geheugen->data = data;
+    for (int s = 0; s < GEHEUGEN_SOORTEN; s++) {
+        atomic_init(&geheugen->allocaties[s], 0);
+        atomic_init(&geheugen->bytes[s], 0);
+        atomic_init(&geheugen->live[s], 0);
+        atomic_init(&geheugen->piek[s], 0);
+    }
+    atomic_init(&geheugen->live_totaal, 0);
+    atomic_init(&geheugen->piek_totaal, 0);
+    return geheugen;
+}
+
+void geheugen_sluit(GEHEUGEN *geheugen)
+{
+    if (geheugen == NULL) {
+        return;
+    }
+    geheugen->bron->vrij(geheugen->data, geheugen, sizeof(GEHEUGEN));
+}
+
+static void verhoog_piek(_Atomic uint64_t *piek, uint64_t live)
+{
+    uint64_t oud = atomic_load_explicit(piek, memory_order_relaxed);
+    while (live > oud && !atomic_compare_exchange_weak_explicit(piek, &oud, live, memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+static void meer(GEHEUGEN *geheugen, GEHEUGEN_SOORT soort, uint64_t bytes)
+{
+    uint64_t live = atomic_fetch_add_explicit(&geheugen->live[soort], bytes, memory_order_relaxed) + bytes;
+    verhoog_piek(&geheugen->piek[soort], live);
+    live = atomic_fetch_add_explicit(&geheugen->live_totaal, bytes, memory_order_relaxed) + bytes;
+    verhoog_piek(&geheugen->piek_totaal, live);
+}
+
+static void minder(GEHEUGEN *geheugen, GEHEUGEN_SOORT soort, uint64_t bytes)
+{
+    atomic_fetch_sub_explicit(&geheugen->live[soort], bytes, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&geheugen->live_totaal, bytes, memory_order_relaxed);
+}
+
+void* geheugen_alloc(GEHEUGEN *geheugen, GEHEUGEN_SOORT soort, size_t size)
+{
+    if (geheugen == NULL) {
+        geheugen = &geheugen_standaard;
+    }
+    kop *k = geheugen->bron->alloc(geheugen->data, sizeof(kop) + size);
+    if (k == NULL) {
+        return NULL;
+    }
+    k->geheugen = geheugen;
+    k->size_soort = size << 4 | soort;
+    atomic_fetch_add_explicit(&geheugen->allocaties[soort], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&geheugen->bytes[soort], size, memory_order_relaxed);
+    meer(geheugen, soort, size);
+    return k + 1;
+}
+
+void* geheugen_nul(GEHEUGEN *geheugen, GEHEUGEN_SOORT soort, size_t aantal, size_t size)
+{
+    void *p = geheugen_alloc(geheugen, soort, aantal * size);
+    if (p != NULL) {
+        memset(p, 0, aantal * size);
+    }
+    return p;
+}
+
+void* geheugen_realloc(GEHEUGEN *geheugen, GEHEUGEN_SOORT soort, void *p, size_t size)
+{
+    if (p == NULL) {
+        return geheugen_alloc(geheugen, soort, size);
+    }
+
+    kop *k = (kop*)p - 1;
+    geheugen = k->geheugen;
+    soort = k->size_soort & 15;
+    size_t oud = k->size_soort >> 4;
+
+    k = geheugen->bron->realloc(geheugen->data, k, sizeof(kop) + oud, sizeof(kop) + size);
+    if (k == NULL) {
+        return NULL;
+    }
+    k->size_soort = size << 4 | soort;
+    atomic_fetch_add_explicit(&geheugen->allocaties[soort], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&geheugen->bytes[soort], size, memory_order_relaxed);
+    if (size > oud) {
+        meer(geheugen, soort, size - oud);
+    } else {
+        minder(geheugen, soort, oud - size);
+    }
+    return k + 1;
+}
+
+void geheugen_vrij(void *p)
+{
+    if (p == NULL) {
+        return;
+    }
+    kop *k = (kop*)p - 1;
+    GEHEUGEN *geheugen = k->geheugen;
+    size_t size = k->size_soort >> 4;
+    minder(geheugen, k->size_soort & 15, size);
+    geheugen->bron->vrij(geheugen->data, k, sizeof(kop) + size);
+}
+
+GEHEUGEN_STAND geheugen_stand(const GEHEUGEN *geheugen, GEHEUGEN_SOORT soort)
+{
+    GEHEUGEN_STAND stand = { 0 };
+    if (soort < GEHEUGEN_SOORTEN) {
+        stand.allocaties = atomic_load(&geheugen->allocaties[soort]);
+        stand.bytes = atomic_load(&geheugen->bytes[soort]);
+        stand.live = atomic_load(&geheugen->live[soort]);
+        stand.piek = atomic_load(&geheugen->piek[soort]);
+    } else {
+        for (int s = 0; s < GEHEUGEN_SOORTEN; s++) {
+            stand.allocaties += atomic_load(&geheugen->allocaties[s]);
+            stand.bytes += atomic_load(&geheugen->bytes[s]);
+        }
+        stand.live = atomic_load(&geheugen->live_totaal);
+        stand.piek = atomic_load(&geheugen->piek_totaal);
+    }
+    return stand;
+}
+
+const char* geheugen_soort_naam(GEHEUGEN_SOORT soort)
+{
+    return soort < GEHEUGEN_SOORTEN ? soort_namen[soort] : "totaal";
+}
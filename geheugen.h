@@ -0,0 +1,92 @@
+#ifndef GEHEUGEN_H
+#define GEHEUGEN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Alle geheugen van lexer, parser, treewalker, vm en interntabel gaat via
+ * deze functies. De aanroeper geeft een allocator (GEHEUGEN) mee; NULL is
+ * geheugen_standaard, gewoon malloc. Een inbedder kan er een eigen bron
+ * onder hangen: een pool, een arena, of iets dat meetelt.
+ *
+ * Elke allocatie heeft een soort, en per allocator en soort wordt exact
+ * bijgehouden hoeveel bytes er nu in gebruik zijn en wat het maximum was.
+ * Daarvoor staat vóór elk blok een kleine kop met de allocator en de
+ * grootte: geheugen_vrij heeft dus geen allocator nodig, maar wat hier
+ * gealloceerd is mag niet met free vrijgegeven worden (en andersom).
+ *
+ * Een GEHEUGEN is van buiten ondoorzichtig: de tellers zijn atomics en
+ * blijven in geheugen.c, zodat deze header ook vanuit C++ te gebruiken is.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    // symbolen en hun posities, het invoervenster van de lexer
+    GEHEUGEN_SYMBOLEN,
+    // de interntabel en tijdelijke tekst van de lexer
+    GEHEUGEN_TEKSTEN,
+    // knopen en lichamen van de syntaxboom
+    GEHEUGEN_BOOM,
+    // variabelen in een omgeving
+    GEHEUGEN_VARIABELEN,
+    // stacks van de vm
+    GEHEUGEN_VM,
+    // de rest: grammatica, programma's en omgevingen van libflut
+    GEHEUGEN_OVERIG,
+    GEHEUGEN_SOORTEN,
+} GEHEUGEN_SOORT;
+
+/*
+ * Waar het geheugen echt vandaan komt. Blokken moeten uitgelijnd zijn zoals
+ * bij malloc. Bij realloc en vrij wordt de grootte meegegeven die eerder
+ * gevraagd is, zodat een pool of arena die niet zelf hoeft te bewaren.
+ * realloc en vrij krijgen nooit NULL.
+ */
+typedef struct {
+    void* (*alloc)(void *data, size_t size);
+    void* (*realloc)(void *data, void *p, size_t oud, size_t nieuw);
+    void (*vrij)(void *data, void *p, size_t size);
+} GEHEUGEN_BRON;
+
+typedef struct geheugen GEHEUGEN;
+
+typedef struct {
+    // aantal aanroepen van geheugen_alloc, _nul en _realloc
+    uint64_t allocaties;
+    // opgevraagde bytes bij elkaar opgeteld (bij realloc de nieuwe grootte)
+    uint64_t bytes;
+    // bytes die nu in gebruik zijn en het hoogste aantal ooit
+    uint64_t live;
+    uint64_t piek;
+} GEHEUGEN_STAND;
+
+// malloc, realloc en free
+extern const GEHEUGEN_BRON geheugen_malloc;
+// Op geheugen_malloc; gebruikt als een functie NULL als allocator krijgt
+extern GEHEUGEN geheugen_standaard;
+
+// Een allocator op bron (NULL: geheugen_malloc), met alle tellers op nul; komt zelf ook uit bron
+GEHEUGEN* geheugen_nieuw(const GEHEUGEN_BRON *bron, void *data);
+// Pas als alles wat eruit gealloceerd is weer vrij is
+void geheugen_sluit(GEHEUGEN *geheugen);
+
+void* geheugen_alloc(GEHEUGEN *geheugen, GEHEUGEN_SOORT soort, size_t size);
+// Zoals calloc: aantal * size bytes, op nul gezet
+void* geheugen_nul(GEHEUGEN *geheugen, GEHEUGEN_SOORT soort, size_t aantal, size_t size);
+// Met p NULL zoals geheugen_alloc; anders blijft het blok bij zijn eigen allocator en soort
+void* geheugen_realloc(GEHEUGEN *geheugen, GEHEUGEN_SOORT soort, void *p, size_t size);
+void geheugen_vrij(void *p);
+
+// soort GEHEUGEN_SOORTEN geeft het totaal over alle soorten
+GEHEUGEN_STAND geheugen_stand(const GEHEUGEN *geheugen, GEHEUGEN_SOORT soort);
+const char* geheugen_soort_naam(GEHEUGEN_SOORT soort);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,188 @@
+#include "incremental.h"
+#include "geheugen.h"
+#include "lexer.h"
+#include "omgeving.h"
+#include "parser.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Bewerkt willekeurige programma's met willekeurige stukjes tekst en
+ * vergelijkt na elke bewerking de boom van incremental_edit met die van
+ * parser over de hele nieuwe tekst. Controleert ook dat een kleine
+ * bewerking in een groot bestand maar een paar statements opnieuw doet, en
+ * dat er aan het einde geen geheugen meer in gebruik is.
+ */
+
+static uint32_t willekeurig_staat = 12345;
+
+static uint32_t willekeurig(void)
+{
+    willekeurig_staat = willekeurig_staat * 1103515245 + 12345;
+    return willekeurig_staat >> 8;
+}
+
+static const char *stukjes[] = {
+    "", " ", "\n", ";", "=", "+", "*", "/", "-", "!", "\"", "{", "}",
+    "a", "b1", "12", "0", "waar", "als", "als 1 { c = 2; }",
+    "x = 1 + 2 * 3;\n", "s = \"tekst\";\n", "y = 4 < 5;", "z = -1;",
+};
+
+static const char* stukje(void)
+{
+    return stukjes[willekeurig() % (sizeof(stukjes) / sizeof(stukjes[0]))];
+}
+
+static bool knopen_gelijk(const PARSER_NODE *a, const PARSER_NODE *b);
+
+static bool lichamen_gelijk(const PARSER_NODE_BODY *a, const PARSER_NODE_BODY *b)
+{
+    if (a->expressions_size != b->expressions_size) {
+        return false;
+    }
+    for (size_t i = 0; i < a->expressions_size; i++) {
+        if (!knopen_gelijk(a->expressions[i], b->expressions[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool knopen_gelijk(const PARSER_NODE *a, const PARSER_NODE *b)
+{
+    if (a == NULL || b == NULL) {
+        return a == b;
+    }
+    if (a->type != b->type) {
+        return false;
+    }
+
+    switch (a->type) {
+        case PARSER_TYPE_LITERAL:
+            if (a->literal != b->literal) {
+                return false;
+            }
+            if (a->literal == PARSER_LITERAL_NUMBER && a->number != b->number) {
+                return false;
+            }
+            if (a->literal == PARSER_LITERAL_STRING && a->string != b->string) {
+                return false;
+            }
+            if (a->literal == PARSER_LITERAL_BOOLEAN && a->boolean != b->boolean) {
+                return false;
+            }
+            break;
+        case PARSER_TYPE_IDENTIFIER:
+            if (a->identifier != b->identifier) {
+                return false;
+            }
+            break;
+        case PARSER_TYPE_OPERATOR:
+            if (a->operator != b->operator) {
+                return false;
+            }
+            break;
+        case PARSER_TYPE_BODY:
+            if (!lichamen_gelijk(&a->body, &b->body)) {
+                return false;
+            }
+            break;
+        case PARSER_TYPE_CONDITIONAL:
+            if (!knopen_gelijk(a->expression, b->expression)) {
+                return false;
+            }
+            break;
+        default:
+            break;
+    }
+    return knopen_gelijk(a->left, b->left) && knopen_gelijk(a->right, b->right);
+}
+
+static bool vergelijk(INCREMENTAL *doc, OMGEVING *omgeving, bool utf8)
+{
+    size_t symbolen_size;
+    LEX_SYMBOL *symbolen = lex_parse_mem(doc->text, doc->text_size, &symbolen_size, NULL, utf8, omgeving->geheugen);
+    PARSER_NODE_BODY *body = parser(omgeving, symbolen, symbolen_size);
+    bool gelijk = lichamen_gelijk(&doc->body, body);
+    if (!gelijk) {
+        printf("FOUT boom verschilt na bewerking van:\n%.*s\n", (int)doc->text_size, doc->text);
+    }
+    parser_free(body);
+    geheugen_vrij(symbolen);
+    return gelijk;
+}
+
+static bool bewerk_willekeurig(OMGEVING *omgeving, bool utf8)
+{
+    char bron[1024] = "";
+    size_t statements = willekeurig() % 40;
+    for (size_t i = 0; i < statements; i++) {
+        const char *s = stukjes[20 + willekeurig() % 4];
+        strcat(bron, s);
+    }
+
+    INCREMENTAL doc;
+    incremental_init(&doc, omgeving, bron, strlen(bron), utf8);
+    bool gelijk = vergelijk(&doc, omgeving, utf8);
+    for (int bewerking = 0; bewerking < 40 && gelijk; bewerking++) {
+        size_t offset = doc.text_size == 0 ? 0 : willekeurig() % (doc.text_size + 1);
+        size_t weg = willekeurig() % 4 == 0 ? willekeurig() % (doc.text_size - offset + 1) % 16 : 0;
+        const char *erbij = stukje();
+        incremental_edit(&doc, offset, weg, erbij, strlen(erbij));
+        gelijk = vergelijk(&doc, omgeving, utf8);
+    }
+    incremental_free(&doc);
+    return gelijk;
+}
+
+// Eén getal veranderen tussen 2000 statements doet alleen dat statement en het vorige opnieuw
+static bool controleer_klein(OMGEVING *omgeving)
+{
+    static char bron[2000 * 24];
+    size_t size = 0;
+    for (int i = 0; i < 2000; i++) {
+        size += sprintf(bron + size, "v%d = %d * 2;\n", i, i);
+    }
+
+    INCREMENTAL doc;
+    incremental_init(&doc, omgeving, bron, size, false);
+    const char *midden = strstr(doc.text, "v1000 = 1000");
+    incremental_edit(&doc, midden - doc.text + 8, 4, "7", 1);
+    bool goed = doc.size == 2000 && doc.reparsed_statements <= 2 && doc.relexed_bytes < 64 && vergelijk(&doc, omgeving, false);
+    if (!goed) {
+        printf("FOUT kleine bewerking deed %zu statements en %zu bytes opnieuw\n", doc.reparsed_statements, doc.relexed_bytes);
+    }
+    incremental_free(&doc);
+    return goed;
+}
+
+int main()
+{
+    int fouten = 0;
+
+    GEHEUGEN *geheugen = geheugen_nieuw(&geheugen_malloc, NULL);
+    // meldingen van de parser over kapotte invoer horen erbij
+    FILE *stil = fopen("/dev/null", "w");
+    OMGEVING omgeving;
+    omgeving_init(&omgeving, stil, geheugen);
+
+    for (int i = 0; i < 1000; i++) {
+        fouten += !bewerk_willekeurig(&omgeving, i % 2 == 0);
+    }
+    fouten += !controleer_klein(&omgeving);
+
+    omgeving_vrij(&omgeving);
+    fclose(stil);
+    GEHEUGEN_STAND totaal = geheugen_stand(geheugen, GEHEUGEN_SOORTEN);
+    geheugen_sluit(geheugen);
+    if (totaal.live != 0) {
+        printf("FOUT %llu bytes niet vrijgegeven\n", (unsigned long long)totaal.live);
+        fouten++;
+    }
+
+    printf("%s\n", fouten == 0 ? "OK" : "MISLUKT");
+    return fouten == 0 ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+#include "incremental.h"
+#include "geheugen.h"
+#include "lexer.h"
+#include <string.h>
+
+struct incremental_tree {
+    PARSER_NODE_BODY *body;
+    // statements of the document that still point into body
+    size_t statements;
+};
+
+// The last statement starting at or before offset; size for the tail
+static size_t statement_at(const INCREMENTAL *doc, size_t offset)
+{
+    size_t low = 0;
+    size_t high = doc->size;
+    while (low < high) {
+        size_t middle = low + (high - low + 1) / 2;
+        if (doc->starts[middle] <= offset) {
+            low = middle;
+        } else {
+            high = middle - 1;
+        }
+    }
+    return low;
+}
+
+static void release(INCREMENTAL_TREE *tree)
+{
+    if (--tree->statements == 0) {
+        parser_free(tree->body);
+        geheugen_vrij(tree);
+    }
+}
+
+static void reserve(INCREMENTAL *doc, size_t size)
+{
+    if (size <= doc->allocated) {
+        return;
+    }
+    while (doc->allocated < size) {
+        doc->allocated = doc->allocated == 0 ? 64 : doc->allocated * 2;
+    }
+    GEHEUGEN *geheugen = doc->omgeving->geheugen;
+    doc->nodes = geheugen_realloc(geheugen, GEHEUGEN_BOOM, doc->nodes, sizeof(PARSER_NODE*) * doc->allocated);
+    doc->trees = geheugen_realloc(geheugen, GEHEUGEN_BOOM, doc->trees, sizeof(INCREMENTAL_TREE*) * doc->allocated);
+    doc->starts = geheugen_realloc(geheugen, GEHEUGEN_BOOM, doc->starts, sizeof(size_t) * (doc->allocated + 1));
+}
+
+/*
+ * Lexes and parses text[start, stop) as top-level statements and puts them
+ * in place of statements [first, end). With end < size the new statements
+ * must end exactly at stop, where statement end starts, or nothing changes
+ * and false is returned: then a token or statement runs on past stop and
+ * more of the text has to be included. Lexing goes on up to lookahead, the
+ * end of statement end, to see where the token at stop really ends.
+ * delta is how far everything from statement end on has moved.
+ */
+static bool reparse(INCREMENTAL *doc, size_t first, size_t end, size_t start, size_t stop, size_t lookahead, size_t delta)
+{
+    GEHEUGEN *geheugen = doc->omgeving->geheugen;
+    bool to_end = end >= doc->size;
+
+    LEX_POSITIES positions;
+    lex_posities_init(&positions, geheugen);
+    size_t symbols_size;
+    LEX_SYMBOL *symbols = lex_parse_mem(doc->text + start, lookahead - start, &symbols_size, &positions, doc->utf8, geheugen);
+    doc->relexed_bytes += lookahead - start;
+
+    // the symbols before stop; with end < size one of them has to start exactly there
+    size_t count = 0;
+    while (count < symbols_size && positions.symbolen[count] < stop - start) {
+        count++;
+    }
+    if (!to_end && (count == symbols_size || positions.symbolen[count] != stop - start)) {
+        geheugen_vrij(symbols);
+        lex_posities_vrij(&positions);
+        return false;
+    }
+
+    size_t *ends = geheugen_alloc(geheugen, GEHEUGEN_BOOM, sizeof(size_t) * (count > 0 ? count : 1));
+    PARSER_NODE_BODY *body = parser_statements(doc->omgeving, symbols, count, ends);
+    size_t statements = body->expressions_size;
+    size_t parsed = statements > 0 ? ends[statements - 1] : 0;
+    if (!to_end && parsed != count) {
+        // a parse error: everything after it is dropped, so the rest has to be parsed again
+        parser_free(body);
+        geheugen_vrij(ends);
+        geheugen_vrij(symbols);
+        lex_posities_vrij(&positions);
+        return false;
+    }
+
+    INCREMENTAL_TREE *tree = NULL;
+    if (statements > 0) {
+        tree = geheugen_alloc(geheugen, GEHEUGEN_BOOM, sizeof(INCREMENTAL_TREE));
+        tree->body = body;
+        tree->statements = statements;
+    } else {
+        parser_free(body);
+    }
+
+    size_t removed = (to_end ? doc->size : end) - first;
+    for (size_t i = first; i < first + removed; i++) {
+        release(doc->trees[i]);
+    }
+
+    // statements after the range move to their new index, and their bytes by delta
+    size_t after = doc->size - first - removed;
+    reserve(doc, doc->size - removed + statements);
+    memmove(doc->nodes + first + statements, doc->nodes + first + removed, sizeof(PARSER_NODE*) * after);
+    memmove(doc->trees + first + statements, doc->trees + first + removed, sizeof(INCREMENTAL_TREE*) * after);
+    memmove(doc->starts + first + statements, doc->starts + first + removed, sizeof(size_t) * (after + 1));
+    for (size_t i = first + statements; i <= first + statements + after; i++) {
+        doc->starts[i] += delta;
+    }
+
+    for (size_t i = 0; i < statements; i++) {
+        doc->nodes[first + i] = body->expressions[i];
+        doc->trees[first + i] = tree;
+        // the first one keeps the whitespace in front of it
+        doc->starts[first + i] = i == 0 ? start : start + positions.symbolen[ends[i - 1]];
+    }
+    doc->size = doc->size - removed + statements;
+
+    if (to_end) {
+        // the tail starts at the statement that failed, or there is none
+        doc->starts[doc->size] = statements == 0 ? start : parsed < count ? start + positions.symbolen[parsed] : doc->text_size;
+    } else if (statements == 0 && first == 0) {
+        // the first statement always starts at 0, it gets the bytes of the range
+        doc->starts[0] = 0;
+    }
+    doc->reparsed_statements += statements;
+
+    doc->body.expressions = doc->nodes;
+    doc->body.expressions_size = doc->size;
+
+    geheugen_vrij(ends);
+    geheugen_vrij(symbols);
+    lex_posities_vrij(&positions);
+    return true;
+}
+
+void incremental_init(INCREMENTAL *doc, OMGEVING *omgeving, const char *text, size_t text_size, bool utf8)
+{
+    memset(doc, 0, sizeof(INCREMENTAL));
+    doc->omgeving = omgeving;
+    doc->utf8 = utf8;
+    reserve(doc, 1);
+    doc->starts[0] = 0;
+    incremental_edit(doc, 0, 0, text, text_size);
+}
+
+bool incremental_edit(INCREMENTAL *doc, size_t offset, size_t remove, const char *insert, size_t insert_size)
+{
+    if (offset > doc->text_size || remove > doc->text_size - offset) {
+        return false;
+    }
+
+    // the statement before the edit is done again too: its end depends on the first token after it
+    size_t first = statement_at(doc, offset);
+    first = first > 0 ? first - 1 : 0;
+    // the first statement after the edit that might stay as it is
+    size_t end = statement_at(doc, offset + remove) + 1;
+
+    size_t text_size = doc->text_size - remove + insert_size;
+    if (doc->text == NULL || text_size > doc->text_allocated) {
+        // room to grow, so typing doesn't copy the whole text every time
+        doc->text_allocated = text_size + text_size / 2 + 64;
+        doc->text = geheugen_realloc(doc->omgeving->geheugen, GEHEUGEN_TEKSTEN, doc->text, doc->text_allocated);
+    }
+    memmove(doc->text + offset + insert_size, doc->text + offset + remove, doc->text_size - offset - remove);
+    if (insert_size > 0) {
+        memcpy(doc->text + offset, insert, insert_size);
+    }
+    doc->text_size = text_size;
+    // starts after the edit move by this much; unsigned, so a shrinking text wraps around to the same result
+    size_t delta = insert_size - remove;
+
+    doc->reparsed_statements = 0;
+    doc->relexed_bytes = 0;
+
+    // every time the range turns out too short, take in twice as many statements as the time before
+    size_t grow = 1;
+    for (;;) {
+        size_t start = doc->starts[first];
+        if (end >= doc->size) {
+            reparse(doc, first, doc->size, start, doc->text_size, doc->text_size, delta);
+            return true;
+        }
+        size_t stop = doc->starts[end] + delta;
+        size_t lookahead = doc->starts[end + 1] + delta;
+        if (reparse(doc, first, end, start, stop, lookahead, delta)) {
+            return true;
+        }
+        end += grow;
+        grow *= 2;
+    }
+}
+
+void incremental_free(INCREMENTAL *doc)
+{
+    for (size_t i = 0; i < doc->size; i++) {
+        release(doc->trees[i]);
+    }
+    geheugen_vrij(doc->nodes);
+    geheugen_vrij(doc->trees);
+    geheugen_vrij(doc->starts);
+    geheugen_vrij(doc->text);
+    memset(doc, 0, sizeof(INCREMENTAL));
+}
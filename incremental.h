@@ -0,0 +1,60 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+#include <stdbool.h>
+#include <stddef.h>
+#include "omgeving.h"
+#include "parser.h"
+
+/*
+ * A source text that is edited piece by piece, as in an editor or REPL, with
+ * its syntax tree kept up to date. An edit re-lexes and re-parses only the
+ * top-level statements it touches and the one before them, whose end
+ * depends on what follows it; every other statement keeps its nodes. The
+ * result is always the tree parser() would build from the whole new text.
+ *
+ * Each top-level statement owns the bytes up to the start of the next one.
+ * Where the parser stopped at an error, everything from there on is the
+ * tail: it has no statements, and an edit that reaches it re-parses all of
+ * it.
+ *
+ * The nodes of each re-parse live in a tree of their own, which is freed
+ * once none of its statements is left.
+ */
+
+typedef struct incremental_tree INCREMENTAL_TREE;
+
+typedef struct {
+    OMGEVING *omgeving;
+    bool utf8;
+
+    char *text;
+    size_t text_size;
+    size_t text_allocated;
+
+    // per top-level statement; starts[size] is where the tail starts
+    PARSER_NODE **nodes;
+    size_t *starts;
+    INCREMENTAL_TREE **trees;
+    size_t size;
+    size_t allocated;
+
+    // the program, its expressions are nodes
+    PARSER_NODE_BODY body;
+
+    // what the last edit did, for tests and statistics
+    size_t reparsed_statements;
+    size_t relexed_bytes;
+} INCREMENTAL;
+
+// Parses the whole text; everything is allocated from omgeving->geheugen
+void incremental_init(INCREMENTAL *doc, OMGEVING *omgeving, const char *text, size_t text_size, bool utf8);
+/*
+ * Replaces remove bytes at offset by insert. Returns false and changes
+ * nothing if that range is not inside the text. doc->body is valid until the
+ * next edit; passes that rewrite the tree, like optimize, must not run on it
+ * because the next edit keeps nodes they would have changed.
+ */
+bool incremental_edit(INCREMENTAL *doc, size_t offset, size_t remove, const char *insert, size_t insert_size);
+void incremental_free(INCREMENTAL *doc);
+
+#endif
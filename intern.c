@@ -0,0 +1,194 @@
+#include "intern.h"
+#include "geheugen.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * De hashtabel is verdeeld in INTERN_DELEN delen met elk een eigen slot, zodat
+ * de threads van de parallelle lexer elkaar zelden tegenhouden. Een deel is
+ * open addressing met lineair zoeken; een gleuf bevat atoom + 1 (0 is leeg).
+ *
+ * De items staan in segmenten die nooit verplaatsen: segment k heeft plaats
+ * voor 1 << (k + INTERN_EERSTE) items. intern_tekst hoeft daardoor niets op
+ * slot te doen.
+ */
+
+#define INTERN_DELEN_BITS 4
+#define INTERN_DELEN (1 << INTERN_DELEN_BITS)
+#define INTERN_EERSTE 10
+#define INTERN_SEGMENTEN (32 - INTERN_EERSTE + 1)
+#define INTERN_BLOK (64 * 1024)
+
+typedef struct {
+    const char *tekst;
+    uint32_t lengte;
+    uint32_t hash;
+} intern_item;
+
+typedef struct {
+    pthread_mutex_t slot;
+
+    uint32_t *gleuven;
+    size_t gleuven_size;
+    size_t gebruikt;
+
+    // de teksten zelf, in blokken van INTERN_BLOK
+    char *blok;
+    size_t blok_size;
+    size_t blok_allocated;
+} intern_deel;
+
+#define DEEL { .slot = PTHREAD_MUTEX_INITIALIZER }
+#define DEEL4 DEEL, DEEL, DEEL, DEEL
+
+static intern_deel delen[INTERN_DELEN] = { DEEL4, DEEL4, DEEL4, DEEL4 };
+
+static intern_item *segmenten[INTERN_SEGMENTEN];
+static uint32_t items_size = 0;
+static pthread_mutex_t items_slot = PTHREAD_MUTEX_INITIALIZER;
+
+// FNV-1a
+static uint32_t intern_hash(const char *tekst, size_t lengte)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < lengte; i++) {
+        hash ^= (unsigned char)tekst[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static intern_item* intern_item_van(INTERN_ATOOM atoom)
+{
+    uint64_t i = (uint64_t)atoom + (1u << INTERN_EERSTE);
+    int segment = 63 - __builtin_clzll(i) - INTERN_EERSTE;
+    return &segmenten[segment][i - ((uint64_t)1 << (segment + INTERN_EERSTE))];
+}
+
+static INTERN_ATOOM intern_nieuw_item(const char *tekst, uint32_t lengte, uint32_t hash)
+{
+    pthread_mutex_lock(&items_slot);
+
+    INTERN_ATOOM atoom = items_size++;
+    uint64_t i = (uint64_t)atoom + (1u << INTERN_EERSTE);
+    int segment = 63 - __builtin_clzll(i) - INTERN_EERSTE;
+    if (segmenten[segment] == NULL) {
+        segmenten[segment] = geheugen_alloc(NULL, GEHEUGEN_TEKSTEN, sizeof(intern_item) << (segment + INTERN_EERSTE));
+    }
+    *intern_item_van(atoom) = (intern_item){ tekst, lengte, hash };
+
+    pthread_mutex_unlock(&items_slot);
+    return atoom;
+}
+
+static const char* intern_bewaar(intern_deel *deel, const char *tekst, size_t lengte)
+{
+    if (deel->blok == NULL || deel->blok_size + lengte + 1 > deel->blok_allocated) {
+        deel->blok_allocated = lengte + 1 > INTERN_BLOK ? lengte + 1 : INTERN_BLOK;
+        deel->blok = geheugen_alloc(NULL, GEHEUGEN_TEKSTEN, deel->blok_allocated);
+        deel->blok_size = 0;
+    }
+
+    char *kopie = deel->blok + deel->blok_size;
+    memcpy(kopie, tekst, lengte);
+    kopie[lengte] = '\0';
+    deel->blok_size += lengte + 1;
+    return kopie;
+}
+
+static void intern_groei(intern_deel *deel)
+{
+    size_t oud_size = deel->gleuven_size;
+    uint32_t *oud = deel->gleuven;
+
+    deel->gleuven_size = oud_size == 0 ? 256 : oud_size * 2;
+    deel->gleuven = geheugen_nul(NULL, GEHEUGEN_TEKSTEN, deel->gleuven_size, sizeof(uint32_t));
+
+    size_t masker = deel->gleuven_size - 1;
+    for (size_t i = 0; i < oud_size; i++) {
+        if (oud[i] == 0) {
+            continue;
+        }
+        size_t g = intern_item_van(oud[i] - 1)->hash & masker;
+        while (deel->gleuven[g] != 0) {
+            g = (g + 1) & masker;
+        }
+        deel->gleuven[g] = oud[i];
+    }
+    geheugen_vrij(oud);
+}
+
+// Zoekt de gleuf van tekst in deel, of de lege gleuf waar hij zou komen; deel is op slot en niet leeg
+static size_t intern_gleuf(const intern_deel *deel, const char *tekst, size_t lengte, uint32_t hash)
+{
+    size_t masker = deel->gleuven_size - 1;
+    size_t g = hash & masker;
+    while (deel->gleuven[g] != 0) {
+        intern_item *item = intern_item_van(deel->gleuven[g] - 1);
+        if (item->hash == hash && item->lengte == lengte && memcmp(item->tekst, tekst, lengte) == 0) {
+            break;
+        }
+        g = (g + 1) & masker;
+    }
+    return g;
+}
+
+INTERN_ATOOM intern_atoom(const char *tekst, size_t lengte)
+{
+    uint32_t hash = intern_hash(tekst, lengte);
+    intern_deel *deel = &delen[hash >> (32 - INTERN_DELEN_BITS)];
+
+    pthread_mutex_lock(&deel->slot);
+
+    // hooguit half vol
+    if (deel->gebruikt * 2 >= deel->gleuven_size) {
+        intern_groei(deel);
+    }
+
+    size_t g = intern_gleuf(deel, tekst, lengte, hash);
+    if (deel->gleuven[g] != 0) {
+        INTERN_ATOOM atoom = deel->gleuven[g] - 1;
+        pthread_mutex_unlock(&deel->slot);
+        return atoom;
+    }
+
+    INTERN_ATOOM atoom = intern_nieuw_item(intern_bewaar(deel, tekst, lengte), lengte, hash);
+    deel->gleuven[g] = atoom + 1;
+    deel->gebruikt++;
+
+    pthread_mutex_unlock(&deel->slot);
+    return atoom;
+}
+
+bool intern_zoek(const char *tekst, size_t lengte, INTERN_ATOOM *atoom)
+{
+    uint32_t hash = intern_hash(tekst, lengte);
+    intern_deel *deel = &delen[hash >> (32 - INTERN_DELEN_BITS)];
+
+    pthread_mutex_lock(&deel->slot);
+    bool gevonden = false;
+    if (deel->gleuven_size > 0) {
+        size_t g = intern_gleuf(deel, tekst, lengte, hash);
+        if (deel->gleuven[g] != 0) {
+            *atoom = deel->gleuven[g] - 1;
+            gevonden = true;
+        }
+    }
+    pthread_mutex_unlock(&deel->slot);
+    return gevonden;
+}
+
+INTERN_TEKST intern_tekst(INTERN_ATOOM atoom)
+{
+    intern_item *item = intern_item_van(atoom);
+    return (INTERN_TEKST){ item->tekst, item->lengte };
+}
+
+size_t intern_aantal(void)
+{
+    pthread_mutex_lock(&items_slot);
+    size_t aantal = items_size;
+    pthread_mutex_unlock(&items_slot);
+    return aantal;
+}
@@ -0,0 +1,31 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Eén tabel voor alle namen en tekenreeksen. Elke verschillende tekst staat
+ * er één keer in en krijgt een atoom van 32 bits; twee teksten zijn gelijk
+ * als hun atomen gelijk zijn. De lexer vult de tabel, parser en treewalker
+ * werken alleen met atomen. Teksten blijven bestaan tot het programma stopt.
+ *
+ * intern_atoom mag vanuit meerdere threads tegelijk aangeroepen worden.
+ */
+typedef uint32_t INTERN_ATOOM;
+
+typedef struct {
+    // nul-getermineerd, maar kan zelf ook nullen bevatten
+    const char *tekst;
+    uint32_t lengte;
+} INTERN_TEKST;
+
+INTERN_ATOOM intern_atoom(const char *tekst, size_t lengte);
+// Alleen opzoeken: false als de tekst niet in de tabel staat, die voegt dan niets toe
+bool intern_zoek(const char *tekst, size_t lengte, INTERN_ATOOM *atoom);
+INTERN_TEKST intern_tekst(INTERN_ATOOM atoom);
+// Aantal verschillende teksten in de tabel
+size_t intern_aantal(void);
+
+#endif
@@ -0,0 +1,257 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Genereert lexer-tabellen.h: een tabel met tekenklassen (256 bytes) en de
+ * overgangstabel van de automaat van de lexer. Operatoren en sleutelwoorden
+ * zitten als trie in de automaat, dus een sleutelwoord herkennen kost niets
+ * extra ten opzichte van een gewone naam. Een nieuw sleutelwoord is één regel
+ * in keywords[] hieronder.
+ *
+ * Spaties en regeleinden slaat de lexer over voordat de automaat begint.
+ * Reeksen (namen, nummers, tekenreeksen) worden niet per teken door de
+ * automaat gelopen: de toestand geeft een actie aan en de lexer laat de
+ * scanner de rest van de reeks in één keer vinden.
+ */
+
+typedef struct {
+    const char *tekst;
+    const char *symbool;
+} patroon;
+
+static const patroon operatoren[] = {
+    { "(", "LEX_SYM_HAAK_OPEN" },
+    { ")", "LEX_SYM_HAAK_SLUIT" },
+    { "{", "LEX_SYM_ACCOLADE_OPEN" },
+    { "}", "LEX_SYM_ACCOLADE_SLUIT" },
+    { ";", "LEX_SYM_PUNTKOMMA" },
+    { "=", "LEX_SYM_IS" },
+    { "==", "LEX_SYM_GELIJK_AAN" },
+    { "!", "LEX_SYM_UITROEPTEKEN" },
+    { "!=", "LEX_SYM_NIET_GELIJK_AAN" },
+    { "<", "LEX_SYM_LAGER_DAN" },
+    { "<=", "LEX_SYM_LAGER_DAN_GELIJK_AAN" },
+    { ">", "LEX_SYM_HOGER_DAN" },
+    { ">=", "LEX_SYM_HOGER_DAN_GELIJK_AAN" },
+    { "+", "LEX_SYM_PLUS" },
+    { "-", "LEX_SYM_MIN" },
+    { "*", "LEX_SYM_KEER" },
+    { "/", "LEX_SYM_DELEN" },
+};
+
+static const patroon keywords[] = {
+    { "waar", "LEX_SYM_WAAR" },
+    { "onwaar", "LEX_SYM_ONWAAR" },
+    { "als", "LEX_SYM_ALS" },
+    { "anders", "LEX_SYM_ANDERS" },
+    { "functie", "LEX_SYM_FUNCTIE" },
+    { "teruggave", "LEX_SYM_TERUGGAVE" },
+};
+
+typedef enum {
+    ACTIE_GEEN,
+    ACTIE_NAAM,
+    ACTIE_NUMMER,
+    ACTIE_TEKENREEKS,
+} ACTIE;
+
+static const char *actie_namen[] = {
+    "LEX_ACTIE_GEEN",
+    "LEX_ACTIE_NAAM",
+    "LEX_ACTIE_NUMMER",
+    "LEX_ACTIE_TEKENREEKS",
+};
+
+#define MAX_KLASSEN 64
+#define MAX_TOESTANDEN 255
+#define STOP -1
+
+typedef struct {
+    int overgang[MAX_KLASSEN];
+    ACTIE actie;
+    const char *accepteer;
+} toestand;
+
+static int klasse[256];
+static int klassen_size = 1; // klasse 0: onbekend teken
+static bool naam_klasse[MAX_KLASSEN];
+static bool letter_klasse[MAX_KLASSEN];
+
+static toestand toestanden[MAX_TOESTANDEN];
+static int toestanden_size = 0;
+
+static int nieuwe_toestand(ACTIE actie, const char *accepteer)
+{
+    if (toestanden_size == MAX_TOESTANDEN) {
+        fprintf(stderr, "Te veel toestanden\n");
+        exit(1);
+    }
+
+    toestand *t = &toestanden[toestanden_size];
+    for (int k = 0; k < MAX_KLASSEN; k++) {
+        t->overgang[k] = STOP;
+    }
+    t->actie = actie;
+    t->accepteer = accepteer;
+
+    return toestanden_size++;
+}
+
+static void eigen_klasse(unsigned char c)
+{
+    if (klasse[c] != 0) {
+        return;
+    }
+    if (klassen_size == MAX_KLASSEN) {
+        fprintf(stderr, "Te veel klassen\n");
+        exit(1);
+    }
+    klasse[c] = klassen_size++;
+}
+
+static bool is_letter(int c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+static bool is_cijfer(int c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static void maak_klassen(void)
+{
+    for (size_t i = 0; i < sizeof(operatoren) / sizeof(operatoren[0]); i++) {
+        for (const char *c = operatoren[i].tekst; *c; c++) {
+            eigen_klasse(*c);
+        }
+    }
+    for (size_t i = 0; i < sizeof(keywords) / sizeof(keywords[0]); i++) {
+        for (const char *c = keywords[i].tekst; *c; c++) {
+            eigen_klasse(*c);
+        }
+    }
+    eigen_klasse('"');
+    eigen_klasse('_');
+
+    // overige letters en alle cijfers delen elk één klasse
+    int letters = klassen_size++;
+    int cijfers = klassen_size++;
+    for (int c = 0; c < 256; c++) {
+        if (is_letter(c) && klasse[c] == 0) {
+            klasse[c] = letters;
+        } else if (is_cijfer(c)) {
+            klasse[c] = cijfers;
+        }
+    }
+
+    for (int c = 0; c < 256; c++) {
+        if (is_letter(c) || is_cijfer(c) || c == '-' || c == '_') {
+            naam_klasse[klasse[c]] = true;
+        }
+        if (is_letter(c)) {
+            letter_klasse[klasse[c]] = true;
+        }
+    }
+}
+
+/*
+ * Voegt tekst toe als pad vanaf start. Een overgang naar STOP of naar
+ * standaard wordt vervangen door een nieuwe toestand. Bij sleutelwoorden is
+ * naam de naam-toestand: elk ander naamteken gaat daarheen.
+ */
+static void voeg_toe(int start, const patroon *p, int standaard, int naam)
+{
+    int huidig = start;
+    for (const char *c = p->tekst; *c; c++) {
+        int k = klasse[(unsigned char)*c];
+        int volgende = toestanden[huidig].overgang[k];
+        if (volgende == STOP || volgende == standaard) {
+            volgende = nieuwe_toestand(ACTIE_GEEN, naam != STOP ? "LEX_SYM_NAAM" : NULL);
+            if (naam != STOP) {
+                // een ander naamteken maakt er een gewone naam van
+                for (int j = 0; j < klassen_size; j++) {
+                    if (naam_klasse[j]) {
+                        toestanden[volgende].overgang[j] = naam;
+                    }
+                }
+            }
+            toestanden[huidig].overgang[k] = volgende;
+        }
+        huidig = volgende;
+    }
+    toestanden[huidig].accepteer = p->symbool;
+}
+
+int main()
+{
+    maak_klassen();
+
+    int start = nieuwe_toestand(ACTIE_GEEN, NULL);
+    int onbekend = nieuwe_toestand(ACTIE_GEEN, "LEX_SYM_ONBEKEND");
+    int naam = nieuwe_toestand(ACTIE_NAAM, "LEX_SYM_NAAM");
+    int nummer = nieuwe_toestand(ACTIE_NUMMER, "LEX_SYM_NUMMER");
+    int tekenreeks = nieuwe_toestand(ACTIE_TEKENREEKS, "LEX_SYM_TEKENREEKS");
+
+    for (int k = 0; k < klassen_size; k++) {
+        toestanden[start].overgang[k] = letter_klasse[k] ? naam : onbekend;
+    }
+    for (int c = '0'; c <= '9'; c++) {
+        toestanden[start].overgang[klasse[c]] = nummer;
+    }
+    toestanden[start].overgang[klasse['"']] = tekenreeks;
+
+    for (size_t i = 0; i < sizeof(operatoren) / sizeof(operatoren[0]); i++) {
+        voeg_toe(start, &operatoren[i], onbekend, STOP);
+    }
+    for (size_t i = 0; i < sizeof(keywords) / sizeof(keywords[0]); i++) {
+        voeg_toe(start, &keywords[i], naam, naam);
+    }
+
+    printf("// Gegenereerd door lexer-gen.c, niet met de hand aanpassen\n");
+    printf("#ifndef LEXER_TABELLEN_H\n#define LEXER_TABELLEN_H\n\n");
+    printf("#include \"lexer.h\"\n#include <stdint.h>\n\n");
+    printf("#define LEX_STOP 255\n");
+    printf("#define LEX_START %d\n", start);
+    printf("#define LEX_KLASSEN %d\n", klassen_size);
+    printf("#define LEX_TOESTANDEN %d\n\n", toestanden_size);
+
+    printf("enum {\n");
+    for (size_t i = 0; i < sizeof(actie_namen) / sizeof(actie_namen[0]); i++) {
+        printf("    %s,\n", actie_namen[i]);
+    }
+    printf("};\n\n");
+
+    printf("static const uint8_t lex_klasse[256] = {");
+    for (int c = 0; c < 256; c++) {
+        printf("%s%d,", c % 16 == 0 ? "\n    " : " ", klasse[c]);
+    }
+    printf("\n};\n\n");
+
+    printf("static const uint8_t lex_overgang[LEX_TOESTANDEN][LEX_KLASSEN] = {\n");
+    for (int t = 0; t < toestanden_size; t++) {
+        printf("    {");
+        for (int k = 0; k < klassen_size; k++) {
+            int o = toestanden[t].overgang[k];
+            printf("%s%d", k == 0 ? "" : ", ", o == STOP ? 255 : o);
+        }
+        printf("},\n");
+    }
+    printf("};\n\n");
+
+    printf("static const uint8_t lex_actie[LEX_TOESTANDEN] = {\n");
+    for (int t = 0; t < toestanden_size; t++) {
+        printf("    %s,\n", actie_namen[toestanden[t].actie]);
+    }
+    printf("};\n\n");
+
+    printf("static const LEX_SYMBOOL_TYPE lex_accepteer[LEX_TOESTANDEN] = {\n");
+    for (int t = 0; t < toestanden_size; t++) {
+        printf("    %s,\n", toestanden[t].accepteer ? toestanden[t].accepteer : "LEX_SYM_ONBEKEND");
+    }
+    printf("};\n\n#endif\n");
+
+    return 0;
+}
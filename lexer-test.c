@@ -0,0 +1,304 @@
+#include "lexer.h"
+#include "scanner.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Vergelijkt de SIMD-scanners byte voor byte met de scalaire versie, en de
+ * symbolen van lex_parse_mem onder elke ISA met die van het scalaire pad.
+ * Controleert ook de regeltabel tegen een naïeve telling, dat
+ * lex_parse_mem_parallel en een stroom hetzelfde opleveren als lex_parse_mem,
+ * en een paar namen met Unicode-letters in UTF-8-modus.
+ */
+
+static uint32_t willekeurig_staat = 12345;
+
+static uint32_t willekeurig(void)
+{
+    willekeurig_staat = willekeurig_staat * 1103515245 + 12345;
+    return willekeurig_staat >> 8;
+}
+
+static void vul_buffer(char *buf, size_t size)
+{
+    static const char alfabet[] = "    aZ09fF_-\"\\\n=!<>+-*/(){};";
+    for (size_t i = 0; i < size; i++) {
+        uint32_t r = willekeurig();
+        if (r % 16 == 0) {
+            // ook bytes buiten ASCII en lange reeksen van dezelfde klasse
+            buf[i] = (char)(r >> 8);
+        } else if (r % 16 < 6 && i > 0) {
+            buf[i] = buf[i-1];
+        } else {
+            buf[i] = alfabet[(r >> 4) % (sizeof(alfabet) - 1)];
+        }
+    }
+}
+
+// Vooral geldige UTF-8 (zodat de validatie ver komt), af en toe een kapotte byte
+static void vul_utf8(char *buf, size_t size)
+{
+    static const char *tekens[] = { "é", "ö", "ß", "ñ", "Ω", "ж", "中", "€", "\xF0\x9F\x98\x80" };
+    vul_buffer(buf, size);
+    for (size_t i = 0; i < size; i++) {
+        unsigned char c = (unsigned char)buf[i];
+        if (c >= 0x80 && willekeurig() % 64 != 0) {
+            const char *teken = tekens[willekeurig() % (sizeof(tekens) / sizeof(tekens[0]))];
+            size_t lengte = strlen(teken);
+            if (i + lengte > size) {
+                buf[i] = 'x';
+                continue;
+            }
+            memcpy(buf + i, teken, lengte);
+            i += lengte - 1;
+        }
+    }
+}
+
+typedef size_t (*scan_functie)(const char *buf, size_t bufsize, size_t offset);
+
+static bool vergelijk_scanners(const char *buf, size_t size, SCAN_ISA isa)
+{
+    scan_functie functies[] = { scan_spaties, scan_naam, scan_nummer, scan_tekenreeks, scan_utf8 };
+    const char *namen[] = { "spaties", "naam", "nummer", "tekenreeks", "utf8" };
+
+    for (size_t f = 0; f < sizeof(functies) / sizeof(functies[0]); f++) {
+        for (size_t offset = 0; offset <= size; offset++) {
+            scan_kies_isa(SCAN_ISA_SCALAIR);
+            size_t verwacht = functies[f](buf, size, offset);
+            scan_kies_isa(isa);
+            size_t gekregen = functies[f](buf, size, offset);
+            if (verwacht != gekregen) {
+                printf("FOUT %s scan_%s offset %zu: %zu != %zu\n",
+                    scan_isa_naam(isa), namen[f], offset, gekregen, verwacht);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool symbolen_gelijk(LEX_SYMBOL a, LEX_SYMBOL b)
+{
+    if (a.type != b.type) {
+        return false;
+    }
+    switch (a.type) {
+        case LEX_SYM_NAAM:
+        case LEX_SYM_TEKENREEKS:
+            return a.atoom == b.atoom;
+        case LEX_SYM_NUMMER:
+            return a.nummer == b.nummer;
+        default:
+            return true;
+    }
+}
+
+static bool vergelijk_lexer(const char *buf, size_t size, SCAN_ISA isa, bool utf8)
+{
+    size_t verwacht_size, gekregen_size;
+
+    scan_kies_isa(SCAN_ISA_SCALAIR);
+    LEX_SYMBOL *verwacht = lex_parse_mem(buf, size, &verwacht_size, NULL, utf8, NULL);
+    scan_kies_isa(isa);
+    LEX_SYMBOL *gekregen = lex_parse_mem(buf, size, &gekregen_size, NULL, utf8, NULL);
+
+    bool gelijk = verwacht_size == gekregen_size;
+    for (size_t i = 0; gelijk && i < verwacht_size; i++) {
+        if (!symbolen_gelijk(verwacht[i], gekregen[i])) {
+            printf("FOUT %s symbool %zu verschilt\n", scan_isa_naam(isa), i);
+            gelijk = false;
+        }
+    }
+    if (verwacht_size != gekregen_size) {
+        printf("FOUT %s %zu symbolen, verwacht %zu\n", scan_isa_naam(isa), gekregen_size, verwacht_size);
+    }
+
+    geheugen_vrij(verwacht);
+    geheugen_vrij(gekregen);
+    return gelijk;
+}
+
+static bool vergelijk_posities(const char *buf, size_t size)
+{
+    LEX_POSITIES posities;
+    size_t symbolen_size;
+
+    lex_posities_init(&posities, NULL);
+    LEX_SYMBOL *symbolen = lex_parse_mem(buf, size, &symbolen_size, &posities, false, NULL);
+
+    bool gelijk = posities.symbolen_size == symbolen_size;
+    for (size_t i = 0; gelijk && i < posities.symbolen_size; i++) {
+        size_t offset = posities.symbolen[i];
+        size_t verwacht_regel = 1, verwacht_kolom = 1;
+        for (size_t j = 0; j < offset; j++) {
+            if (buf[j] == '\n') {
+                verwacht_regel++;
+                verwacht_kolom = 1;
+            } else {
+                verwacht_kolom++;
+            }
+        }
+
+        size_t regel, kolom;
+        lex_positie(&posities, offset, &regel, &kolom);
+        if (regel != verwacht_regel || kolom != verwacht_kolom) {
+            printf("FOUT positie symbool %zu: %zu:%zu, verwacht %zu:%zu\n",
+                i, regel, kolom, verwacht_regel, verwacht_kolom);
+            gelijk = false;
+        }
+    }
+
+    geheugen_vrij(symbolen);
+    lex_posities_vrij(&posities);
+    return gelijk;
+}
+
+static bool vergelijk_parallel(const char *buf, size_t size, size_t threads, bool utf8)
+{
+    LEX_POSITIES verwacht_posities, gekregen_posities;
+    size_t verwacht_size, gekregen_size;
+
+    lex_posities_init(&verwacht_posities, NULL);
+    lex_posities_init(&gekregen_posities, NULL);
+    LEX_SYMBOL *verwacht = lex_parse_mem(buf, size, &verwacht_size, &verwacht_posities, utf8, NULL);
+    LEX_SYMBOL *gekregen = lex_parse_mem_parallel(buf, size, &gekregen_size, &gekregen_posities, utf8, threads, NULL);
+
+    bool gelijk = verwacht_size == gekregen_size;
+    if (verwacht_posities.regels_size != gekregen_posities.regels_size
+        || memcmp(verwacht_posities.regels, gekregen_posities.regels, sizeof(uint32_t) * verwacht_posities.regels_size) != 0) {
+        printf("FOUT parallel (%zu threads) regeltabel verschilt\n", threads);
+        gelijk = false;
+    }
+    if (verwacht_size != gekregen_size) {
+        printf("FOUT parallel (%zu threads) %zu symbolen, verwacht %zu\n", threads, gekregen_size, verwacht_size);
+    }
+    for (size_t i = 0; gelijk && i < verwacht_size; i++) {
+        if (!symbolen_gelijk(verwacht[i], gekregen[i]) || verwacht_posities.symbolen[i] != gekregen_posities.symbolen[i]) {
+            printf("FOUT parallel (%zu threads) symbool %zu verschilt\n", threads, i);
+            gelijk = false;
+        }
+    }
+
+    geheugen_vrij(verwacht);
+    geheugen_vrij(gekregen);
+    lex_posities_vrij(&verwacht_posities);
+    lex_posities_vrij(&gekregen_posities);
+    return gelijk;
+}
+
+// Een stroom uit een bestand (in blokken gelezen) tegen lex_parse_mem
+static bool vergelijk_stroom(const char *buf, size_t size, bool utf8)
+{
+    size_t verwacht_size;
+    LEX_SYMBOL *verwacht = lex_parse_mem(buf, size, &verwacht_size, NULL, utf8, NULL);
+
+    FILE *bestand = tmpfile();
+    fwrite(buf, 1, size, bestand);
+    rewind(bestand);
+
+    LEX_STROOM stroom;
+    lex_open_bestand(&stroom, bestand, NULL);
+    stroom.utf8 = utf8;
+
+    bool gelijk = true;
+    size_t i = 0;
+    for (LEX_SYMBOL symbool = lex_next(&stroom); symbool.type != LEX_SYM_EINDE; symbool = lex_next(&stroom), i++) {
+        if (i >= verwacht_size || !symbolen_gelijk(verwacht[i], symbool)) {
+            printf("FOUT stroom%s symbool %zu verschilt\n", utf8 ? " (utf8)" : "", i);
+            gelijk = false;
+            break;
+        }
+    }
+    if (gelijk && i != verwacht_size) {
+        printf("FOUT stroom%s %zu symbolen, verwacht %zu\n", utf8 ? " (utf8)" : "", i, verwacht_size);
+        gelijk = false;
+    }
+
+    lex_sluit(&stroom);
+    fclose(bestand);
+    geheugen_vrij(verwacht);
+    return gelijk;
+}
+
+static bool controleer_namen(void)
+{
+    static const struct {
+        const char *tekst;
+        LEX_SYMBOOL_TYPE types[4];
+        const char *naam;
+    } gevallen[] = {
+        { "privé = coördinaat;", { LEX_SYM_NAAM, LEX_SYM_IS, LEX_SYM_NAAM, LEX_SYM_PUNTKOMMA }, "privé" },
+        { "alsé als", { LEX_SYM_NAAM, LEX_SYM_ALS, LEX_SYM_EINDE }, "alsé" },
+        { "Ωmega_ж", { LEX_SYM_NAAM, LEX_SYM_EINDE }, "Ωmega_ж" },
+        { "€ x", { LEX_SYM_ONBEKEND, LEX_SYM_NAAM, LEX_SYM_EINDE }, NULL },
+        { "a \xC3(", { LEX_SYM_NAAM, LEX_SYM_ONBEKEND, LEX_SYM_EINDE }, "a" },
+    };
+
+    bool gelijk = true;
+    for (size_t g = 0; g < sizeof(gevallen) / sizeof(gevallen[0]); g++) {
+        size_t size;
+        LEX_SYMBOL *symbolen = lex_parse_mem(gevallen[g].tekst, strlen(gevallen[g].tekst), &size, NULL, true, NULL);
+        for (size_t i = 0; i < 4 && gevallen[g].types[i] != LEX_SYM_EINDE; i++) {
+            if (i >= size || symbolen[i].type != gevallen[g].types[i]) {
+                printf("FOUT utf8 \"%s\" symbool %zu\n", gevallen[g].tekst, i);
+                gelijk = false;
+                break;
+            }
+        }
+        const char *naam = gevallen[g].naam;
+        if (naam != NULL && (size == 0 || symbolen[0].atoom != intern_atoom(naam, strlen(naam)))) {
+            printf("FOUT utf8 \"%s\" naam\n", gevallen[g].tekst);
+            gelijk = false;
+        }
+        geheugen_vrij(symbolen);
+    }
+    return gelijk;
+}
+
+int main()
+{
+    SCAN_ISA beste = scan_beste_isa();
+    int fouten = 0;
+    char buf[1024];
+
+    printf("beste ISA: %s\n", scan_isa_naam(beste));
+
+    for (int ronde = 0; ronde < 200; ronde++) {
+        size_t size = willekeurig() % sizeof(buf);
+
+        // oneven rondes in UTF-8-modus op UTF-8-achtige invoer
+        bool utf8 = ronde % 2 == 1;
+        if (utf8) {
+            vul_utf8(buf, size);
+        } else {
+            vul_buffer(buf, size);
+        }
+
+        if (!vergelijk_posities(buf, size) || !vergelijk_stroom(buf, size, utf8)) {
+            fouten++;
+        }
+        for (size_t threads = 1; threads <= 8; threads++) {
+            if (!vergelijk_parallel(buf, size, threads, utf8)) {
+                fouten++;
+            }
+        }
+
+        for (SCAN_ISA isa = SCAN_ISA_SSE2; isa <= beste; isa++) {
+            if (!vergelijk_scanners(buf, size, isa) || !vergelijk_lexer(buf, size, isa, utf8)) {
+                fouten++;
+            }
+        }
+    }
+
+    if (!controleer_namen()) {
+        fouten++;
+    }
+
+    printf("%s\n", fouten == 0 ? "OK" : "MISLUKT");
+    return fouten == 0 ? 0 : 1;
+}
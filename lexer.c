@@ -1,366 +1,818 @@
+#define _POSIX_C_SOURCE 200809L
 #include "lexer.h"
-#include <ctype.h>
+#include "geheugen.h"
+#include "lexer-tabellen.h"
+#include "scanner.h"
+#include "unicode.h"
+#include <inttypes.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 typedef struct {
     LEX_SYMBOL *syms;
     size_t size;
     size_t allocated;
+    GEHEUGEN *geheugen;
 } sym_array;
 
-static void sym_array_init(sym_array *s)
+static void sym_array_init(sym_array *s, GEHEUGEN *geheugen)
 {
     s->size = 0;
     s->allocated = 128;
-    s->syms = malloc(sizeof(LEX_SYMBOL) * s->allocated);
+    s->geheugen = geheugen;
+    s->syms = geheugen_alloc(geheugen, GEHEUGEN_SYMBOLEN, sizeof(LEX_SYMBOL) * s->allocated);
 }
 
 static void sym_array_add(sym_array *s, LEX_SYMBOL symbol)
 {
     if (s->allocated == s->size) {
-        s->allocated += 128;
-        s->syms = realloc(s->syms, sizeof(LEX_SYMBOL) * s->allocated);
+        s->allocated *= 2;
+        s->syms = geheugen_realloc(s->geheugen, GEHEUGEN_SYMBOLEN, s->syms, sizeof(LEX_SYMBOL) * s->allocated);
     }
 
     s->syms[s->size] = symbol;
     s->size++;
 }
 
-static bool end_of_string(int c)
+/*
+ * Leest een tekenreeks vanaf offset (na de openende '"') tot de sluitende '"'.
+ * Zonder escapes gaat de tekst direct uit de buffer de interntabel in; alleen
+ * met een '\' erin wordt hij eerst ontsleuteld. Geeft het aantal gelezen
+ * bytes terug, zonder de sluitende '"'.
+ */
+static size_t parse_tekenreeks(const char *buf, size_t buf_size, size_t offset, LEX_SYMBOL *symbool)
 {
-    if (c == '"') {
-        return false;
+    size_t lengte = 0;
+    bool escapes = false;
+    while (true) {
+        // spring in één keer naar de eerste '"' of '\\'
+        lengte += scan_tekenreeks(buf, buf_size, offset + lengte);
+        if (offset + lengte >= buf_size || buf[offset + lengte] == '"') {
+            break;
+        }
+        if (offset + lengte + 1 < buf_size) {
+            escapes = true;
+            lengte++;
+        }
+        lengte++;
+    }
+
+    symbool->type = LEX_SYM_TEKENREEKS;
+    if (!escapes) {
+        symbool->atoom = intern_atoom(buf + offset, lengte);
+        return lengte;
+    }
+
+    char *kopie = geheugen_alloc(NULL, GEHEUGEN_TEKSTEN, lengte);
+    size_t kopie_lengte = 0;
+    for (size_t i = offset; i < offset + lengte; i++) {
+        char c = buf[i];
+        if (c == '\\' && i + 1 < offset + lengte) {
+            i++;
+            switch (buf[i]) {
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+                case '"': c = '"'; break;
+                case '\\': c = '\\'; break;
+                default:
+                    // onbekende escape blijft staan zoals hij is
+                    kopie[kopie_lengte++] = '\\';
+                    c = buf[i];
+                    break;
+            }
+        }
+        kopie[kopie_lengte++] = c;
+    }
+
+    symbool->atoom = intern_atoom(kopie, kopie_lengte);
+    geheugen_vrij(kopie);
+    return lengte;
+}
+
+// Zelfde betekenis als strtol(tekst, NULL, 0), maar zonder nul-terminator
+static int64_t parse_nummer(const char *tekst, size_t lengte)
+{
+    int grondtal = tekst[0] == '0' ? 8 : 10;
+    int64_t nummer = 0;
+    for (size_t i = 0; i < lengte; i++) {
+        int cijfer = tekst[i] - '0';
+        if (cijfer < 0 || cijfer >= grondtal) {
+            break;
+        }
+        if (nummer > (INT64_MAX - cijfer) / grondtal) {
+            return INT64_MAX;
+        }
+        nummer = nummer * grondtal + cijfer;
     }
-    return true;
+    return nummer;
 }
 
-static bool end_of_name(int c)
+static void posities_add(GEHEUGEN *geheugen, uint32_t **array, size_t *size, size_t *allocated, size_t offset)
 {
-    if (isalnum(c) || c == '-' || c == '_') {
-        return true;
+    if (*size == *allocated) {
+        *allocated = *allocated == 0 ? 1024 : *allocated * 2;
+        *array = geheugen_realloc(geheugen, GEHEUGEN_SYMBOLEN, *array, sizeof(uint32_t) * *allocated);
     }
-    return false;
+    (*array)[(*size)++] = offset;
 }
 
-static bool end_of_number(int c)
+static void posities_reserveer(GEHEUGEN *geheugen, uint32_t **array, size_t *allocated, size_t nodig)
 {
-    if (isxdigit(c)) {
-        return true;
+    if (nodig > *allocated) {
+        *allocated = nodig;
+        *array = geheugen_realloc(geheugen, GEHEUGEN_SYMBOLEN, *array, sizeof(uint32_t) * *allocated);
     }
-    return false;
 }
 
-static char* parse_string(char *buf, size_t buf_size, size_t string_offset, bool (*is_valid)(int))
+void lex_posities_init(LEX_POSITIES *posities, GEHEUGEN *geheugen)
+{
+    memset(posities, 0, sizeof(LEX_POSITIES));
+    posities->geheugen = geheugen;
+    posities_add(geheugen, &posities->regels, &posities->regels_size, &posities->regels_allocated, 0);
+}
+
+void lex_posities_vrij(LEX_POSITIES *posities)
+{
+    geheugen_vrij(posities->symbolen);
+    geheugen_vrij(posities->regels);
+    GEHEUGEN *geheugen = posities->geheugen;
+    memset(posities, 0, sizeof(LEX_POSITIES));
+    posities->geheugen = geheugen;
+}
+
+void lex_positie(const LEX_POSITIES *posities, size_t offset, size_t *regel, size_t *kolom)
 {
-    size_t string_size = 0;
-    size_t string_allocated = 128;
-    char *string = malloc(string_allocated);
-    while (string_offset + string_size < buf_size) {
-        if (string_size == string_allocated) {
-            string_allocated += 128;
-            string = realloc(string, string_allocated);
+    // laatste regel die op of voor offset begint
+    size_t laag = 0;
+    size_t hoog = posities->regels_size;
+    while (hoog - laag > 1) {
+        size_t midden = laag + (hoog - laag) / 2;
+        if (posities->regels[midden] <= offset) {
+            laag = midden;
+        } else {
+            hoog = midden;
         }
+    }
 
-        if (!is_valid(buf[string_offset + string_size])) {
-            string[string_size] = '\0';
+    *regel = laag + 1;
+    *kolom = offset - posities->regels[laag] + 1;
+}
+
+static void lex_nieuwe_regel(size_t *regel, LEX_POSITIES *posities, size_t begin)
+{
+    ++*regel;
+    if (posities != NULL) {
+        posities_add(posities->geheugen, &posities->regels, &posities->regels_size, &posities->regels_allocated, begin);
+    }
+}
+
+/*
+ * Slaat spaties en regeleinden over vanaf i en geeft de positie erna terug.
+ * Het begin van elke nieuwe regel komt in de regeltabel; basis is de offset
+ * van buf[0] in de hele invoer.
+ */
+static size_t lex_tussenruimte(const char *buf, size_t bufsize, size_t i, size_t basis, size_t *regel, LEX_POSITIES *posities)
+{
+    while (i < bufsize) {
+        if (buf[i] == ' ') {
+            i += scan_spaties(buf, bufsize, i);
+        } else if (buf[i] == '\n') {
+            i++;
+            lex_nieuwe_regel(regel, posities, basis + i);
+        } else {
             break;
         }
+    }
+    return i;
+}
 
-        string[string_size] = buf[string_offset + string_size];
-        string_size++;
+// Een tekenreeks kan over meerdere regels lopen
+static void lex_regels_in(const char *buf, size_t begin, size_t einde, size_t basis, size_t *regel, LEX_POSITIES *posities)
+{
+    const char *regeleinde = memchr(buf + begin, '\n', einde - begin);
+    while (regeleinde != NULL) {
+        size_t volgende = regeleinde - buf + 1;
+        lex_nieuwe_regel(regel, posities, basis + volgende);
+        regeleinde = memchr(buf + volgende, '\n', einde - volgende);
     }
+}
 
-    string = realloc(string, string_size);
+// Lengte van een naamteken buiten ASCII op i, anders 0
+static size_t lex_utf8_naamteken(const char *buf, size_t bufsize, size_t i)
+{
+    uint32_t codepunt;
+    if (i >= bufsize || (unsigned char)buf[i] < 0x80) {
+        return 0;
+    }
+    size_t lengte = scan_utf8_teken(buf, bufsize, i, &codepunt);
+    return lengte > 0 && unicode_naam(codepunt) ? lengte : 0;
+}
 
-    return string;
+// Rest van een naam: stukken ASCII via de scanner, daartussen Unicode per teken
+static size_t lex_naam_utf8(const char *buf, size_t bufsize, size_t i)
+{
+    while (true) {
+        i += scan_naam(buf, bufsize, i);
+        size_t lengte = lex_utf8_naamteken(buf, bufsize, i);
+        if (lengte == 0) {
+            return i;
+        }
+        i += lengte;
+    }
 }
 
-typedef struct {
-    char *keyword;
-    LEX_SYMBOOL_TYPE symbool;
-} keyword;
+/*
+ * Leest één symbool vanaf i (geen spatie of regeleinde) en geeft de positie
+ * erna terug. De automaat uit lexer-tabellen.h (gegenereerd door lexer-gen)
+ * herkent operatoren en sleutelwoorden teken voor teken. Komt hij in een
+ * toestand met een actie, dan vindt de scanner de rest van de reeks in één
+ * keer.
+ *
+ * Met utf8 mogen namen ook Unicode-letters bevatten. Alleen een byte vanaf
+ * 0x80 gaat die kant op, dus ASCII kost niets extra.
+ */
+static size_t lex_symbool(const char *buf, size_t bufsize, size_t i, bool utf8, LEX_SYMBOL *symbool)
+{
+    size_t begin = i;
+    uint8_t toestand = LEX_START;
 
-const keyword keywords[] = {
-    { .keyword = "waar", .symbool = LEX_SYM_WAAR },
-    { .keyword = "onwaar", .symbool = LEX_SYM_ONWAAR },
-    { .keyword = "als", .symbool = LEX_SYM_ALS },
-    { .keyword = "functie", .symbool = LEX_SYM_FUNCTIE },
-    { .keyword = "teruggave", .symbool = LEX_SYM_TERUGGAVE },
-};
+    if (utf8 && (unsigned char)buf[i] >= 0x80) {
+        uint32_t codepunt;
+        size_t lengte = scan_utf8_teken(buf, bufsize, i, &codepunt);
+        if (lengte > 0 && unicode_naam_begin(codepunt)) {
+            i = lex_naam_utf8(buf, bufsize, i + lengte);
+            *symbool = (LEX_SYMBOL){
+                .type = LEX_SYM_NAAM,
+                .atoom = intern_atoom(buf + begin, i - begin)
+            };
+            return i;
+        }
+        *symbool = (LEX_SYMBOL){
+            .type = LEX_SYM_ONBEKEND
+        };
+        return i + (lengte > 0 ? lengte : 1);
+    }
 
-LEX_SYMBOOL_TYPE is_keyword(char *str) {
-    size_t keywords_size = sizeof(keywords) / sizeof(keyword);
-    for (size_t i = 0; i < keywords_size; i++) {
-        // TEDOEN traag want stopt niet onmiddelijk bij ongelijke tekenreeks
-        if (strcmp(keywords[i].keyword, str) == 0) {
-            return keywords[i].symbool;
+    do {
+        uint8_t volgende = lex_overgang[toestand][lex_klasse[(unsigned char)buf[i]]];
+        if (volgende == LEX_STOP) {
+            break;
         }
+        toestand = volgende;
+        i++;
+    } while (lex_actie[toestand] == LEX_ACTIE_GEEN && i < bufsize);
+
+    switch (lex_actie[toestand]) {
+        case LEX_ACTIE_NAAM:
+            i = utf8 ? lex_naam_utf8(buf, bufsize, i) : i + scan_naam(buf, bufsize, i);
+            *symbool = (LEX_SYMBOL){
+                .type = LEX_SYM_NAAM,
+                .atoom = intern_atoom(buf + begin, i - begin)
+            };
+            break;
+        case LEX_ACTIE_NUMMER:
+            i += scan_nummer(buf, bufsize, i);
+            *symbool = (LEX_SYMBOL){
+                .type = LEX_SYM_NUMMER,
+                .nummer = parse_nummer(buf + begin, i - begin)
+            };
+            break;
+        case LEX_ACTIE_TEKENREEKS:
+            i += parse_tekenreeks(buf, bufsize, i, symbool) + 1;
+            break;
+        default:
+            // operator, sleutelwoord of een naam die als sleutelwoord begon
+            if (utf8 && scan_is(buf[begin], SCAN_KLASSE_LETTER) && lex_utf8_naamteken(buf, bufsize, i) > 0) {
+                i = lex_naam_utf8(buf, bufsize, i);
+                *symbool = (LEX_SYMBOL){
+                    .type = LEX_SYM_NAAM,
+                    .atoom = intern_atoom(buf + begin, i - begin)
+                };
+            } else if (lex_accepteer[toestand] == LEX_SYM_NAAM) {
+                *symbool = (LEX_SYMBOL){
+                    .type = LEX_SYM_NAAM,
+                    .atoom = intern_atoom(buf + begin, i - begin)
+                };
+            } else {
+                *symbool = (LEX_SYMBOL){
+                    .type = lex_accepteer[toestand]
+                };
+            }
+            break;
     }
-    return LEX_SYM_ONBEKEND;
+
+    return i;
 }
 
-LEX_SYMBOL* lex_parse_mem(char *buf, size_t bufsize, size_t *symbols_size)
+/*
+ * Lext alle symbolen die beginnen in [begin, eind) en geeft de positie na het
+ * laatste symbool terug. Een tekenreeks mag voorbij eind doorlopen; spaties en
+ * regeleinden na eind zijn voor het volgende stuk.
+ */
+static size_t lex_bereik(const char *buf, size_t bufsize, size_t begin, size_t eind, bool utf8, sym_array *syms, LEX_POSITIES *posities)
 {
-    size_t syms_allocated = 128;
-    sym_array syms;
-    size_t i = 0;
+    size_t i = begin;
     size_t huidige_regel = 1;
-    char *tekenreeks = NULL;
+    LEX_SYMBOL symbool;
 
-    sym_array_init(&syms);
+    while (true) {
+        i = lex_tussenruimte(buf, eind, i, 0, &huidige_regel, posities);
+        if (i >= eind) {
+            break;
+        }
 
-    sym_array_add(&syms, (LEX_SYMBOL){
-        .type = LEX_SYM_REGEL, .nummer = huidige_regel
-    });
+        size_t symbool_begin = i;
+        i = lex_symbool(buf, bufsize, i, utf8, &symbool);
+        if (i > bufsize) {
+            i = bufsize;
+        }
+        sym_array_add(syms, symbool);
 
-    while (i < bufsize) {
-        char current = buf[i];
-        switch (current) {
-            case '"':
-                tekenreeks = parse_string(buf, bufsize, i+1, end_of_string);
-                sym_array_add(&syms, (LEX_SYMBOL){
-                    .type = LEX_SYM_TEKENREEKS,
-                    .tekenreeks = tekenreeks
-                });
-                i += strlen(tekenreeks) + 1;
-                tekenreeks = NULL;
-                break;
-            case '(':
-                sym_array_add(&syms, (LEX_SYMBOL){
-                    .type = LEX_SYM_HAAK_OPEN
-                });
-                break;
-            case ')':
-                sym_array_add(&syms, (LEX_SYMBOL){
-                    .type = LEX_SYM_HAAK_SLUIT
-                });
-                break;
-            case '{':
-                sym_array_add(&syms, (LEX_SYMBOL){
-                    .type = LEX_SYM_ACCOLADE_OPEN
-                });
-                break;
-            case '}':
-                sym_array_add(&syms, (LEX_SYMBOL){
-                    .type = LEX_SYM_ACCOLADE_SLUIT
-                });
-                break;
-            case ' ':
-                sym_array_add(&syms, (LEX_SYMBOL){
-                    .type = LEX_SYM_SPATIE
-                });
-                break;
-            case ';':
-                sym_array_add(&syms, (LEX_SYMBOL){
-                    .type = LEX_SYM_PUNTKOMMA
-                });
-                break;
-            case '=':
-                // check voor '=='
-                if (i+1 < bufsize) {
-                    if (buf[i+1] == '=') {
-                        sym_array_add(&syms, (LEX_SYMBOL){
-                            .type = LEX_SYM_GELIJK_AAN
-                        });
-                        i++;
-                        break;
-                    }
-                }
-                sym_array_add(&syms, (LEX_SYMBOL){
-                    .type = LEX_SYM_IS
-                });
-                break;
-            case '!':
-                // check voor '!='
-                if (i+1 < bufsize) {
-                    if (buf[i+1] == '=') {
-                        sym_array_add(&syms, (LEX_SYMBOL){
-                            .type = LEX_SYM_NIET_GELIJK_AAN
-                        });
-                        i++;
-                        break;
-                    }
-                }
-                sym_array_add(&syms, (LEX_SYMBOL){
-                    .type = LEX_SYM_UITROEPTEKEN
-                });
-                break;
-            case '<':
-                // check voor '<='
-                if (i+1 < bufsize) {
-                    if (buf[i+1] == '=') {
-                        sym_array_add(&syms, (LEX_SYMBOL){
-                            .type = LEX_SYM_LAGER_DAN_GELIJK_AAN
-                        });
-                        i++;
-                        break;
-                    }
-                }
-                sym_array_add(&syms, (LEX_SYMBOL){
-                    .type = LEX_SYM_LAGER_DAN
-                });
-                break;
-            case '>':
-                // check voor '>='
-                if (i+1 < bufsize) {
-                    if (buf[i+1] == '=') {
-                        sym_array_add(&syms, (LEX_SYMBOL){
-                            .type = LEX_SYM_HOGER_DAN_GELIJK_AAN
-                        });
-                        i++;
-                        break;
-                    }
-                }
-                sym_array_add(&syms, (LEX_SYMBOL){
-                    .type = LEX_SYM_HOGER_DAN
-                });
-                break;
-            case '+':
-                sym_array_add(&syms, (LEX_SYMBOL){
-                    .type = LEX_SYM_PLUS
-                });
-                break;
-            case '-':
-                sym_array_add(&syms, (LEX_SYMBOL){
-                    .type = LEX_SYM_MIN
-                });
-                break;
-            case '*':
-                sym_array_add(&syms, (LEX_SYMBOL){
-                    .type = LEX_SYM_KEER
-                });
-                break;
-            case '/':
-                sym_array_add(&syms, (LEX_SYMBOL){
-                    .type = LEX_SYM_DELEN
-                });
-                break;
-            case '\n':
-                sym_array_add(&syms, (LEX_SYMBOL){
-                    .type = LEX_SYM_REGEL,
-                    .nummer = ++huidige_regel
-                });
-                break;
-            default:
-                if (isalpha(current)) {
-                    tekenreeks = parse_string(buf, bufsize, i, end_of_name);
-
-                    LEX_SYMBOOL_TYPE symbool = is_keyword(tekenreeks);
-                    if (symbool != 0) {
-                        sym_array_add(&syms, (LEX_SYMBOL){
-                            .type = symbool
-                        });
-                    } else {
-                        sym_array_add(&syms, (LEX_SYMBOL){
-                            .type = LEX_SYM_NAAM,
-                            .tekenreeks = tekenreeks
-                        });
-                    }
-
-                    i += strlen(tekenreeks);
-                    tekenreeks = NULL;
-                    continue;
-                } else if (isdigit(current)) {
-                    tekenreeks = parse_string(buf, bufsize, i, end_of_number);
-                    sym_array_add(&syms, (LEX_SYMBOL){
-                        .type = LEX_SYM_NUMMER,
-                        .nummer = strtol(tekenreeks, NULL, 0)
-                    });
-                    i += strlen(tekenreeks);
-                    tekenreeks = NULL;
-                    continue;
-                } else {
-                    sym_array_add(&syms, (LEX_SYMBOL){
-                        .type = LEX_SYM_ONBEKEND
-                    });
-                    break;
-                }
+        if (posities != NULL) {
+            posities_add(posities->geheugen, &posities->symbolen, &posities->symbolen_size, &posities->symbolen_allocated, symbool_begin);
         }
-        i++;
+        if (symbool.type == LEX_SYM_TEKENREEKS) {
+            lex_regels_in(buf, symbool_begin, i, 0, &huidige_regel, posities);
+        }
+    }
+
+    return i;
+}
+
+// Een ongeldige UTF-8-byte wordt een onbekend symbool, daarna stopt de lexer
+static void lex_ongeldig(sym_array *syms, LEX_POSITIES *posities, size_t offset)
+{
+    sym_array_add(syms, (LEX_SYMBOL){ .type = LEX_SYM_ONBEKEND });
+    if (posities != NULL) {
+        posities_add(posities->geheugen, &posities->symbolen, &posities->symbolen_size, &posities->symbolen_allocated, offset);
+    }
+}
+
+LEX_SYMBOL* lex_parse_mem(const char *buf, size_t bufsize, size_t *symbols_size, LEX_POSITIES *posities, bool utf8, GEHEUGEN *geheugen)
+{
+    if (bufsize >= LEX_PARALLEL_DREMPEL) {
+        return lex_parse_mem_parallel(buf, bufsize, symbols_size, posities, utf8, 0, geheugen);
+    }
+
+    sym_array syms;
+    sym_array_init(&syms, geheugen);
+
+    size_t geldig = utf8 ? scan_utf8(buf, bufsize, 0) : bufsize;
+    lex_bereik(buf, geldig, 0, geldig, utf8, &syms, posities);
+    if (geldig < bufsize) {
+        lex_ongeldig(&syms, posities, geldig);
     }
 
     *symbols_size = syms.size;
     return syms.syms;
 }
 
-void lex_debug_print(LEX_SYMBOL *symbols, size_t size)
+typedef struct {
+    const char *buf;
+    size_t bufsize;
+    size_t begin;
+    size_t eind;
+
+    sym_array syms;
+    LEX_POSITIES posities;
+    size_t einde;
+    bool utf8;
+
+    pthread_t id;
+    bool thread;
+} lex_stuk;
+
+static void* lex_stuk_thread(void *arg)
 {
-    for (size_t i = 0; i < size; i++) {
-        LEX_SYMBOL symbool = symbols[i];
-        switch (symbool.type) {
-            case LEX_SYM_ONBEKEND:
-                putchar('?');
-                break;
-            case LEX_SYM_SPATIE:
-                putchar(' ');
-                break;
-            case LEX_SYM_TEKENREEKS:
-                printf("\"%s\"", symbool.tekenreeks);
-                break;
-            case LEX_SYM_HAAK_OPEN:
-                putchar('(');
-                break;
-            case LEX_SYM_HAAK_SLUIT:
-                putchar(')');
-                break;
-            case LEX_SYM_ACCOLADE_OPEN:
-                putchar('{');
-                break;
-            case LEX_SYM_ACCOLADE_SLUIT:
-                putchar('}');
-                break;
-            case LEX_SYM_PUNTKOMMA:
-                putchar(';');
-                break;
-            case LEX_SYM_IS:
-                putchar('=');
-                break;
-            case LEX_SYM_UITROEPTEKEN:
-                putchar('!');
-                break;
-            case LEX_SYM_PLUS:
-                putchar('+');
-                break;
-            case LEX_SYM_MIN:
-                putchar('-');
-                break;
-            case LEX_SYM_KEER:
-                putchar('*');
-                break;
-            case LEX_SYM_DELEN:
-                putchar('/');
-                break;
-            case LEX_SYM_WAAR:
-                printf("waar");
-                break;
-            case LEX_SYM_ONWAAR:
-                printf("onwaar");
-                break;
-            case LEX_SYM_FUNCTIE:
-                printf("functie");
-                break;
-            case LEX_SYM_TERUGGAVE:
-                printf("teruggave");
-                break;
-            case LEX_SYM_NAAM:
-                printf("%s", symbool.tekenreeks);
-                break;
-            case LEX_SYM_NUMMER:
-                printf("%ld", symbool.nummer);
-                break;
-            case LEX_SYM_REGEL:
-                if (symbool.nummer != 1) {
-                    putchar('\n');
+    lex_stuk *stuk = arg;
+    stuk->einde = lex_bereik(stuk->buf, stuk->bufsize, stuk->begin, stuk->eind, stuk->utf8, &stuk->syms, &stuk->posities);
+    return NULL;
+}
+
+static void lex_stuk_leeg(lex_stuk *stuk)
+{
+    stuk->syms.size = 0;
+    stuk->posities.symbolen_size = 0;
+    stuk->posities.regels_size = 0;
+}
+
+/*
+ * Splitst de buffer op regeleinden en lext de stukken tegelijk. Elk stuk
+ * begint alsof er geen symbool doorloopt; alleen een tekenreeks kan over een
+ * regeleinde lopen. Loopt het laatste symbool van een stuk door in het
+ * volgende, dan wordt dat stuk bij het samenvoegen opnieuw gelext vanaf het
+ * einde van dat symbool. Offsets zijn absoluut, dus de regeltabellen kunnen
+ * achter elkaar gezet worden.
+ */
+LEX_SYMBOL* lex_parse_mem_parallel(const char *buf, size_t bufsize, size_t *symbols_size, LEX_POSITIES *posities, bool utf8, size_t threads, GEHEUGEN *geheugen)
+{
+    // de validatie haalt de geheugenbandbreedte, dus die gaat vooraf in één keer
+    size_t volledig = bufsize;
+    bufsize = utf8 ? scan_utf8(buf, bufsize, 0) : bufsize;
+
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (size_t)online : 1;
+    }
+
+    lex_stuk *stukken = geheugen_nul(geheugen, GEHEUGEN_SYMBOLEN, threads, sizeof(lex_stuk));
+    size_t stukken_size = 0;
+    size_t begin = 0;
+    // altijd minstens één stuk, ook voor een lege buffer
+    do {
+        size_t eind = bufsize;
+        if (stukken_size + 1 < threads) {
+            size_t doel = bufsize / threads * (stukken_size + 1);
+            if (doel < begin) {
+                doel = begin;
+            }
+            const char *regeleinde = memchr(buf + doel, '\n', bufsize - doel);
+            if (regeleinde != NULL) {
+                eind = regeleinde - buf + 1;
+            }
+        }
+
+        lex_stuk *stuk = &stukken[stukken_size++];
+        stuk->buf = buf;
+        stuk->bufsize = bufsize;
+        stuk->begin = begin;
+        stuk->eind = eind;
+        stuk->utf8 = utf8;
+        sym_array_init(&stuk->syms, geheugen);
+        stuk->posities.geheugen = geheugen;
+        begin = eind;
+    } while (begin < bufsize && stukken_size < threads);
+
+    for (size_t i = 1; i < stukken_size; i++) {
+        stukken[i].thread = pthread_create(&stukken[i].id, NULL, lex_stuk_thread, &stukken[i]) == 0;
+        if (!stukken[i].thread) {
+            // geen thread gekregen: dan hier
+            lex_stuk_thread(&stukken[i]);
+        }
+    }
+    lex_stuk_thread(&stukken[0]);
+    for (size_t i = 1; i < stukken_size; i++) {
+        if (stukken[i].thread) {
+            pthread_join(stukken[i].id, NULL);
+        }
+    }
+
+    size_t einde = 0;
+    size_t totaal = 0, totaal_regels = 0;
+    for (size_t i = 0; i < stukken_size; i++) {
+        lex_stuk *stuk = &stukken[i];
+        if (stuk->begin != einde) {
+            lex_stuk_leeg(stuk);
+            stuk->einde = lex_bereik(buf, bufsize, einde > stuk->eind ? stuk->eind : einde, stuk->eind, utf8, &stuk->syms, &stuk->posities);
+            if (stuk->einde < einde) {
+                stuk->einde = einde;
+            }
+        }
+        einde = stuk->einde;
+        totaal += stuk->syms.size;
+        totaal_regels += stuk->posities.regels_size;
+    }
+    if (bufsize < volledig) {
+        lex_ongeldig(&stukken[stukken_size - 1].syms, &stukken[stukken_size - 1].posities, bufsize);
+        totaal++;
+    }
+
+    LEX_SYMBOL *symbolen = geheugen_alloc(geheugen, GEHEUGEN_SYMBOLEN, sizeof(LEX_SYMBOL) * (totaal > 0 ? totaal : 1));
+    if (posities != NULL) {
+        posities_reserveer(posities->geheugen, &posities->symbolen, &posities->symbolen_allocated, posities->symbolen_size + totaal);
+        posities_reserveer(posities->geheugen, &posities->regels, &posities->regels_allocated, posities->regels_size + totaal_regels);
+    }
+
+    size_t symbolen_size = 0;
+    for (size_t i = 0; i < stukken_size; i++) {
+        lex_stuk *stuk = &stukken[i];
+        memcpy(symbolen + symbolen_size, stuk->syms.syms, sizeof(LEX_SYMBOL) * stuk->syms.size);
+        symbolen_size += stuk->syms.size;
+        if (posities != NULL && stuk->posities.symbolen_size > 0) {
+            memcpy(posities->symbolen + posities->symbolen_size, stuk->posities.symbolen, sizeof(uint32_t) * stuk->posities.symbolen_size);
+            posities->symbolen_size += stuk->posities.symbolen_size;
+        }
+        if (posities != NULL && stuk->posities.regels_size > 0) {
+            memcpy(posities->regels + posities->regels_size, stuk->posities.regels, sizeof(uint32_t) * stuk->posities.regels_size);
+            posities->regels_size += stuk->posities.regels_size;
+        }
+        geheugen_vrij(stuk->syms.syms);
+        lex_posities_vrij(&stuk->posities);
+    }
+    geheugen_vrij(stukken);
+
+    *symbols_size = symbolen_size;
+    return symbolen;
+}
+
+static void lex_open(LEX_STROOM *s)
+{
+    memset(s, 0, sizeof(LEX_STROOM));
+    s->regel = 1;
+    s->einde_invoer = true;
+}
+
+void lex_open_mem(LEX_STROOM *s, const char *buf, size_t bufsize)
+{
+    lex_open(s);
+    s->buf = buf;
+    s->bufsize = bufsize;
+}
+
+void lex_open_bestand(LEX_STROOM *s, FILE *bestand, GEHEUGEN *geheugen)
+{
+    lex_open(s);
+    s->bestand = bestand;
+    s->einde_invoer = false;
+    s->venster_allocated = LEX_BLOK;
+    s->venster = geheugen_alloc(geheugen, GEHEUGEN_SYMBOLEN, s->venster_allocated);
+    s->buf = s->venster;
+}
+
+void lex_open_symbolen(LEX_STROOM *s, const LEX_SYMBOL *symbolen, size_t symbolen_size)
+{
+    lex_open(s);
+    s->symbolen = symbolen;
+    s->symbolen_size = symbolen_size;
+}
+
+void lex_sluit(LEX_STROOM *s)
+{
+    geheugen_vrij(s->venster);
+    s->venster = NULL;
+}
+
+// Schuift het ongelezen deel naar voren en leest het volgende blok erachter
+static void lex_lees(LEX_STROOM *s)
+{
+    size_t rest = s->bufsize - s->positie;
+    memmove(s->venster, s->venster + s->positie, rest);
+    s->basis += s->positie;
+    s->positie = 0;
+    s->bufsize = rest;
+
+    // een symbool langer dan het venster: venster groeit
+    if (s->venster_allocated - rest < LEX_BLOK / 2) {
+        s->venster_allocated *= 2;
+        s->venster = geheugen_realloc(NULL, GEHEUGEN_SYMBOLEN, s->venster, s->venster_allocated);
+    }
+    s->buf = s->venster;
+
+    size_t gevraagd = s->venster_allocated - rest;
+    size_t gelezen = fread(s->venster + rest, 1, gevraagd, s->bestand);
+    s->bufsize += gelezen;
+    if (gelezen < gevraagd) {
+        s->einde_invoer = true;
+        s->leesfout = ferror(s->bestand) != 0;
+    }
+}
+
+/*
+ * Valideert het nieuwe deel van het venster; geldig is een absolute offset.
+ * Een teken dat door het einde van het venster is afgebroken wordt na het
+ * volgende blok opnieuw bekeken.
+ */
+static void lex_valideer(LEX_STROOM *s)
+{
+    size_t vanaf = s->geldig - s->basis;
+    size_t tot = vanaf + scan_utf8(s->buf, s->bufsize, vanaf);
+    if (tot < s->bufsize && (s->einde_invoer || s->bufsize - tot >= 4)) {
+        s->ongeldig = true;
+    }
+    s->geldig = s->basis + tot;
+}
+
+static bool lex_produceer(LEX_STROOM *s, LEX_SYMBOL *symbool)
+{
+    if (!s->begonnen) {
+        s->begonnen = true;
+        if (s->debug != NULL) {
+            fprintf(s->debug, "%zu: ", s->regel);
+        }
+        if (s->utf8) {
+            lex_valideer(s);
+        }
+    }
+
+    while (true) {
+        // met utf8 wordt alleen het gevalideerde deel gelext
+        size_t eind = s->utf8 ? s->geldig - s->basis : s->bufsize;
+        bool einde_invoer = s->einde_invoer || s->ongeldig;
+
+        size_t na = lex_tussenruimte(s->buf, eind, s->positie, s->basis, &s->regel, s->posities);
+        if (s->debug != NULL) {
+            lex_debug_print_tussenruimte(s->debug, s->buf + s->positie, na - s->positie, s->regel);
+        }
+        s->positie = na;
+
+        if (s->positie < eind) {
+            size_t einde = lex_symbool(s->buf, eind, s->positie, s->utf8, symbool);
+
+            // tot het einde van het venster gelezen: het symbool kan nog doorlopen
+            if (einde < eind || einde_invoer) {
+                if (s->posities != NULL) {
+                    posities_add(s->posities->geheugen, &s->posities->symbolen, &s->posities->symbolen_size, &s->posities->symbolen_allocated, s->basis + s->positie);
+                }
+                if (symbool->type == LEX_SYM_TEKENREEKS) {
+                    lex_regels_in(s->buf, s->positie, einde < eind ? einde : eind, s->basis, &s->regel, s->posities);
                 }
-                printf("%li: ", symbool.nummer);
-                break;
-            default:
-                printf("?%d", symbool.type);
-                break;
+                s->positie = einde;
+                return true;
+            }
+        } else if (s->ongeldig && !s->fout_gemeld) {
+            s->fout_gemeld = true;
+            *symbool = (LEX_SYMBOL){ .type = LEX_SYM_ONBEKEND };
+            if (s->posities != NULL) {
+                posities_add(s->posities->geheugen, &s->posities->symbolen, &s->posities->symbolen_size, &s->posities->symbolen_allocated, s->geldig);
+            }
+            return true;
+        } else if (einde_invoer) {
+            return false;
+        }
+
+        lex_lees(s);
+        if (s->utf8) {
+            lex_valideer(s);
+        }
+    }
+}
+
+const LEX_SYMBOL* lex_peek(LEX_STROOM *s, size_t vooruit)
+{
+    static const LEX_SYMBOL einde = { .type = LEX_SYM_EINDE };
+
+    if (s->symbolen != NULL) {
+        if (s->index + vooruit < s->symbolen_size) {
+            return &s->symbolen[s->index + vooruit];
+        }
+        return &einde;
+    }
+
+    while (s->vooruit_size <= vooruit && vooruit < LEX_VOORUIT) {
+        LEX_SYMBOL *plek = &s->vooruit[(s->vooruit_begin + s->vooruit_size) % LEX_VOORUIT];
+        if (!lex_produceer(s, plek)) {
+            return &einde;
+        }
+        if (s->debug != NULL) {
+            lex_debug_print_symbool(s->debug, *plek);
+        }
+        s->vooruit_size++;
+    }
+    if (vooruit >= LEX_VOORUIT) {
+        return &einde;
+    }
+
+    return &s->vooruit[(s->vooruit_begin + vooruit) % LEX_VOORUIT];
+}
+
+LEX_SYMBOL lex_next(LEX_STROOM *s)
+{
+    LEX_SYMBOL symbool = *lex_peek(s, 0);
+    if (symbool.type == LEX_SYM_EINDE) {
+        return symbool;
+    }
+
+    if (s->symbolen == NULL) {
+        s->vooruit_begin = (s->vooruit_begin + 1) % LEX_VOORUIT;
+        s->vooruit_size--;
+    }
+    s->index++;
+
+    return symbool;
+}
+
+void lex_debug_print_symbool(FILE *uit, LEX_SYMBOL symbool)
+{
+    switch (symbool.type) {
+        case LEX_SYM_ONBEKEND:
+            fputc('?', uit);
+            break;
+        case LEX_SYM_TEKENREEKS: {
+            INTERN_TEKST tekst = intern_tekst(symbool.atoom);
+            fprintf(uit, "\"%.*s\"", (int)tekst.lengte, tekst.tekst);
+            break;
+        }
+        case LEX_SYM_HAAK_OPEN:
+            fputc('(', uit);
+            break;
+        case LEX_SYM_HAAK_SLUIT:
+            fputc(')', uit);
+            break;
+        case LEX_SYM_ACCOLADE_OPEN:
+            fputc('{', uit);
+            break;
+        case LEX_SYM_ACCOLADE_SLUIT:
+            fputc('}', uit);
+            break;
+        case LEX_SYM_PUNTKOMMA:
+            fputc(';', uit);
+            break;
+        case LEX_SYM_IS:
+            fputc('=', uit);
+            break;
+        case LEX_SYM_UITROEPTEKEN:
+            fputc('!', uit);
+            break;
+        case LEX_SYM_GELIJK_AAN:
+            fprintf(uit, "==");
+            break;
+        case LEX_SYM_NIET_GELIJK_AAN:
+            fprintf(uit, "!=");
+            break;
+        case LEX_SYM_LAGER_DAN:
+            fputc('<', uit);
+            break;
+        case LEX_SYM_LAGER_DAN_GELIJK_AAN:
+            fprintf(uit, "<=");
+            break;
+        case LEX_SYM_HOGER_DAN:
+            fputc('>', uit);
+            break;
+        case LEX_SYM_HOGER_DAN_GELIJK_AAN:
+            fprintf(uit, ">=");
+            break;
+        case LEX_SYM_PLUS:
+            fputc('+', uit);
+            break;
+        case LEX_SYM_MIN:
+            fputc('-', uit);
+            break;
+        case LEX_SYM_KEER:
+            fputc('*', uit);
+            break;
+        case LEX_SYM_DELEN:
+            fputc('/', uit);
+            break;
+        case LEX_SYM_WAAR:
+            fprintf(uit, "waar");
+            break;
+        case LEX_SYM_ALS:
+            fprintf(uit, "als");
+            break;
+        case LEX_SYM_ANDERS:
+            fprintf(uit, "anders");
+            break;
+        case LEX_SYM_ONWAAR:
+            fprintf(uit, "onwaar");
+            break;
+        case LEX_SYM_FUNCTIE:
+            fprintf(uit, "functie");
+            break;
+        case LEX_SYM_TERUGGAVE:
+            fprintf(uit, "teruggave");
+            break;
+        case LEX_SYM_NAAM: {
+            INTERN_TEKST tekst = intern_tekst(symbool.atoom);
+            fprintf(uit, "%.*s", (int)tekst.lengte, tekst.tekst);
+            break;
+        }
+        case LEX_SYM_NUMMER:
+            fprintf(uit, "%" PRId64, symbool.nummer);
+            break;
+        default:
+            fprintf(uit, "?%d", symbool.type);
+            break;
+    }
+}
+
+// Print overgeslagen spaties en regeleinden; regel is het nummer na de laatste
+void lex_debug_print_tussenruimte(FILE *uit, const char *tekst, size_t lengte, size_t regel)
+{
+    size_t regels = 0;
+    for (size_t i = 0; i < lengte; i++) {
+        if (tekst[i] == '\n') {
+            regels++;
+        }
+    }
+
+    regel -= regels;
+    for (size_t i = 0; i < lengte; i++) {
+        if (tekst[i] == '\n') {
+            fprintf(uit, "\n%zu: ", ++regel);
+        } else {
+            fputc(tekst[i], uit);
+        }
+    }
+}
+
+void lex_debug_print(FILE *uit, LEX_SYMBOL *symbols, size_t size, const LEX_POSITIES *posities)
+{
+    size_t vorige_regel = 0;
+    for (size_t i = 0; i < size; i++) {
+        if (posities != NULL && i < posities->symbolen_size) {
+            size_t regel, kolom;
+            lex_positie(posities, posities->symbolen[i], &regel, &kolom);
+            if (regel != vorige_regel) {
+                fprintf(uit, "%s%zu: ", vorige_regel == 0 ? "" : "\n", regel);
+                vorige_regel = regel;
+            }
         }
+        lex_debug_print_symbool(uit, symbols[i]);
+        fputc(' ', uit);
     }
-    putchar('\n');
+    fputc('\n', uit);
 }
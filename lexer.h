@@ -1,12 +1,15 @@
 #ifndef LEXER_H
 #define LEXER_H
 
+#include "geheugen.h"
+#include "intern.h"
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <stdio.h>
 
 typedef enum {
     LEX_SYM_ONBEKEND,
-    LEX_SYM_SPATIE,
     LEX_SYM_HAAK_OPEN,
     LEX_SYM_HAAK_SLUIT,
     LEX_SYM_ACCOLADE_OPEN,
@@ -36,23 +39,130 @@ typedef enum {
     LEX_SYM_FUNCTIE,
     LEX_SYM_TERUGGAVE,
 
+    // einde van de invoer, alleen van lex_peek en lex_next
+    LEX_SYM_EINDE,
+
     /* types met extra data */
-    LEX_SYM_REGEL,
     LEX_SYM_NAAM,
     LEX_SYM_TEKENREEKS,
     LEX_SYM_NUMMER,
 } LEX_SYMBOOL_TYPE;
 
+/*
+ * Bij LEX_SYM_NAAM en LEX_SYM_TEKENREEKS staat de tekst in de interntabel
+ * (intern.h); gelijke namen hebben hetzelfde atoom. De bronbuffer hoeft niet
+ * te blijven bestaan na het lexen.
+ */
 typedef struct {
     LEX_SYMBOOL_TYPE type;
     union {
-        char *tekenreeks;
+        INTERN_ATOOM atoom;
         int64_t nummer;
     };
 } LEX_SYMBOL;
 
-LEX_SYMBOL* lex_parse_mem(char *buf, size_t bufsize, size_t *symbols_size);
+/*
+ * Bronposities naast de symbolen, als struct-of-arrays: de byte-offset van
+ * elk symbool en van het begin van elke regel. Spaties en regeleinden zijn
+ * zelf geen symbolen. Offsets zijn 32 bits om de tabellen klein te houden.
+ */
+typedef struct {
+    uint32_t *symbolen;
+    size_t symbolen_size;
+    size_t symbolen_allocated;
+
+    // regels[0] is altijd 0, regels[n] is het begin van regel n+1
+    uint32_t *regels;
+    size_t regels_size;
+    size_t regels_allocated;
+
+    GEHEUGEN *geheugen;
+} LEX_POSITIES;
+
+// De tabellen komen uit geheugen (NULL: geheugen_standaard)
+void lex_posities_init(LEX_POSITIES *posities, GEHEUGEN *geheugen);
+void lex_posities_vrij(LEX_POSITIES *posities);
+// Zoekt regel en kolom (beide vanaf 1) van een byte-offset, O(log n)
+void lex_positie(const LEX_POSITIES *posities, size_t offset, size_t *regel, size_t *kolom);
+
+#define LEX_VOORUIT 8
+#define LEX_BLOK (64 * 1024)
+
+/*
+ * Stroom van symbolen die pas gelext worden als de parser erom vraagt. De bron
+ * is een buffer in het geheugen, een bestand of pijp (gelezen in blokken van
+ * LEX_BLOK bytes) of een al gelexte array. Er worden nooit meer dan
+ * LEX_VOORUIT symbolen tegelijk bewaard.
+ *
+ * Bij een bestand wordt het venster hergebruikt; namen en tekenreeksen staan
+ * in de interntabel, dus de symbolen blijven geldig na lex_sluit.
+ */
+typedef struct {
+    const LEX_SYMBOL *symbolen;
+    size_t symbolen_size;
+
+    FILE *bestand;
+    char *venster;
+    size_t venster_allocated;
+
+    const char *buf;
+    size_t bufsize;
+    size_t positie;
+    // offset van buf[0] in de hele invoer
+    size_t basis;
+    size_t regel;
+    bool einde_invoer;
+    // fread gaf een fout; einde_invoer is dan ook gezet
+    bool leesfout;
+    bool begonnen;
+
+    LEX_SYMBOL vooruit[LEX_VOORUIT];
+    size_t vooruit_begin;
+    size_t vooruit_size;
+
+    // aantal symbolen dat al met lex_next is gelezen
+    size_t index;
+
+    // vult de posities als dit niet NULL is (groeit met de invoer)
+    LEX_POSITIES *posities;
+
+    // print elk symbool naar dit bestand zodra het gelext is (NULL: niet printen)
+    FILE *debug;
+
+    // invoer is UTF-8: wordt gevalideerd en namen mogen Unicode-letters bevatten
+    bool utf8;
+    // tot hier is de invoer geldig (absolute offset); bij ongeldig staat daar de fout
+    size_t geldig;
+    bool ongeldig;
+    bool fout_gemeld;
+} LEX_STROOM;
+
+// Vanaf deze grootte lext lex_parse_mem in stukken op alle processors
+#define LEX_PARALLEL_DREMPEL (8 * 1024 * 1024)
+
+/*
+ * posities mag NULL zijn. Met utf8 wordt de invoer eerst gevalideerd; bij een
+ * ongeldige byte is het laatste symbool LEX_SYM_ONBEKEND op die plek. De
+ * symbolen komen uit geheugen (NULL: geheugen_standaard) en worden met
+ * geheugen_vrij vrijgegeven.
+ */
+LEX_SYMBOL* lex_parse_mem(const char *buf, size_t bufsize, size_t *symbols_size, LEX_POSITIES *posities, bool utf8, GEHEUGEN *geheugen);
+// Zelfde resultaat als lex_parse_mem, met threads stukken tegelijk (0: aantal processors)
+LEX_SYMBOL* lex_parse_mem_parallel(const char *buf, size_t bufsize, size_t *symbols_size, LEX_POSITIES *posities, bool utf8, size_t threads, GEHEUGEN *geheugen);
+
+void lex_open_mem(LEX_STROOM *s, const char *buf, size_t bufsize);
+// Het venster komt uit geheugen (NULL: geheugen_standaard)
+void lex_open_bestand(LEX_STROOM *s, FILE *bestand, GEHEUGEN *geheugen);
+void lex_open_symbolen(LEX_STROOM *s, const LEX_SYMBOL *symbolen, size_t symbolen_size);
+void lex_sluit(LEX_STROOM *s);
+
+// Kijk vooruit zonder te lezen, vooruit < LEX_VOORUIT; geeft LEX_SYM_EINDE aan het einde
+const LEX_SYMBOL* lex_peek(LEX_STROOM *s, size_t vooruit);
+LEX_SYMBOL lex_next(LEX_STROOM *s);
 
-void lex_debug_print(LEX_SYMBOL *symbols, size_t size);
+void lex_debug_print_symbool(FILE *uit, LEX_SYMBOL symbool);
+void lex_debug_print_tussenruimte(FILE *uit, const char *tekst, size_t lengte, size_t regel);
+// posities mag NULL zijn; dan zonder regelnummers
+void lex_debug_print(FILE *uit, LEX_SYMBOL *symbols, size_t size, const LEX_POSITIES *posities);
 
 #endif
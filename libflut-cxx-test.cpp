@@ -0,0 +1,37 @@
+#include "libflut.h"
+#include <cstdio>
+#include <cstring>
+
+/*
+ * libflut.h en geheugen.h moeten ook in C++ bruikbaar zijn: dit compileert
+ * ze als C++, linkt tegen libflut.so en voert één klein script uit. Zo is
+ * ook zeker dat een host niet meer nodig heeft dan de flut_*-functies.
+ */
+
+int main()
+{
+    static const char bron[] = "x = 1 + 2 * 3;\ns = \"hallo\";\n";
+
+    FLUT_GEHEUGEN *geheugen = flut_geheugen_nieuw(nullptr, nullptr);
+    FLUT_PROGRAMMA *programma = flut_compileer(bron, sizeof(bron) - 1, false, nullptr, geheugen);
+    FLUT_OMGEVING *omgeving = flut_omgeving_nieuw(nullptr, geheugen);
+    if (programma == nullptr || omgeving == nullptr) {
+        std::printf("MISLUKT\n");
+        return 1;
+    }
+    flut_voer_uit(programma, omgeving);
+
+    uint32_t x = 0;
+    const char *s = nullptr;
+    size_t s_lengte = 0;
+    bool goed = flut_lees_getal(omgeving, "x", &x) && x == 7
+        && flut_lees_tekst(omgeving, "s", &s, &s_lengte) && s_lengte == 5 && std::memcmp(s, "hallo", 5) == 0;
+
+    flut_omgeving_vrij(omgeving);
+    flut_programma_vrij(programma);
+    goed = goed && flut_geheugen_stand(geheugen, GEHEUGEN_SOORTEN).live == 0;
+    flut_geheugen_sluit(geheugen);
+
+    std::printf("%s\n", goed ? "OK" : "MISLUKT");
+    return goed ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+#define _POSIX_C_SOURCE 200809L
+#include "libflut.h"
+#include "geheugen.h"
+#include "intern.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Compileert één script en voert het vaak uit, met een nieuwe, een
+ * leeggemaakte en een hergebruikte omgeving, en met een variabele die de
+ * host vooraf zet. Alles gaat via een eigen allocator die bijhoudt hoeveel
+ * blokken er nog open staan; aan het einde moet dat nul zijn. Teksten van de
+ * host en namen die alleen opgezocht worden mogen de interntabel niet laten
+ * groeien.
+ */
+
+static const char bron[] =
+    "x = 1 + 2 * 3;\n"
+    "s = \"hallo\";\n"
+    "als 1 { y = 4; }\n";
+
+static void* tel_alloc(void *data, size_t size)
+{
+    ++*(size_t*)data;
+    return malloc(size);
+}
+
+static void* tel_realloc(void *data, void *p, size_t oud, size_t nieuw)
+{
+    (void)data;
+    (void)oud;
+    return realloc(p, nieuw);
+}
+
+static void tel_vrij(void *data, void *p, size_t size)
+{
+    (void)size;
+    --*(size_t*)data;
+    free(p);
+}
+
+static const GEHEUGEN_BRON tel_bron = {
+    .alloc = tel_alloc,
+    .realloc = tel_realloc,
+    .vrij = tel_vrij,
+};
+
+static bool controleer(const FLUT_OMGEVING *omgeving, const char *wanneer)
+{
+    uint32_t x, y;
+    const char *s;
+    size_t s_lengte;
+
+    if (!flut_lees_getal(omgeving, "x", &x) || x != 7
+        || !flut_lees_getal(omgeving, "y", &y) || y != 4
+        || !flut_lees_tekst(omgeving, "s", &s, &s_lengte) || s_lengte != 5 || memcmp(s, "hallo", 5) != 0) {
+        printf("FOUT %s\n", wanneer);
+        return false;
+    }
+    return true;
+}
+
+int main()
+{
+    int fouten = 0;
+
+    size_t open_blokken = 0;
+    FLUT_GEHEUGEN *geheugen = flut_geheugen_nieuw(&tel_bron, &open_blokken);
+
+    FLUT_PROGRAMMA *programma = flut_compileer(bron, sizeof(bron) - 1, false, NULL, geheugen);
+    if (programma == NULL) {
+        printf("FOUT compileren\n");
+        return 1;
+    }
+
+    for (int i = 0; i < 1000; i++) {
+        FLUT_OMGEVING *omgeving = flut_omgeving_nieuw(NULL, geheugen);
+        flut_voer_uit(programma, omgeving);
+        fouten += !controleer(omgeving, "nieuwe omgeving");
+        flut_omgeving_vrij(omgeving);
+    }
+
+    // alleen "invoer" en "tekst" komen erbij
+    size_t namen = intern_aantal() + 2;
+    FLUT_OMGEVING *omgeving = flut_omgeving_nieuw(NULL, geheugen);
+    for (int i = 0; i < 1000; i++) {
+        // invoer van de host blijft staan naast wat het script zet
+        flut_zet_getal(omgeving, "invoer", i);
+        char tekst[32];
+        int tekst_lengte = snprintf(tekst, sizeof(tekst), "verzoek %d", i);
+        flut_zet_tekst(omgeving, "tekst", "vorige", 6);
+        flut_zet_tekst(omgeving, "tekst", tekst, tekst_lengte);
+        flut_voer_uit(programma, omgeving);
+        uint32_t invoer;
+        if (!flut_lees_getal(omgeving, "invoer", &invoer) || invoer != (uint32_t)i) {
+            printf("FOUT invoer\n");
+            fouten++;
+        }
+        const char *gelezen;
+        size_t gelezen_lengte;
+        if (!flut_lees_tekst(omgeving, "tekst", &gelezen, &gelezen_lengte) || gelezen_lengte != (size_t)tekst_lengte
+            || strcmp(gelezen, tekst) != 0) {
+            printf("FOUT tekst van de host\n");
+            fouten++;
+        }
+        char onbekend[32];
+        snprintf(onbekend, sizeof(onbekend), "onbekend_%d", i);
+        if (flut_lees_getal(omgeving, onbekend, &invoer) || flut_lees_tekst(omgeving, onbekend, &gelezen, &gelezen_lengte)) {
+            printf("FOUT onbekende naam gevonden\n");
+            fouten++;
+        }
+        fouten += !controleer(omgeving, "hergebruikte omgeving");
+
+        if (i % 2 == 0) {
+            flut_omgeving_leeg(omgeving);
+            uint32_t x;
+            if (flut_lees_getal(omgeving, "x", &x)) {
+                printf("FOUT leeggemaakte omgeving\n");
+                fouten++;
+            }
+        }
+    }
+    if (flut_geheugen_stand(geheugen, GEHEUGEN_BOOM).live == 0 || flut_geheugen_stand(geheugen, GEHEUGEN_VARIABELEN).live == 0) {
+        printf("FOUT geen boom of variabelen geteld\n");
+        fouten++;
+    }
+    if (intern_aantal() > namen) {
+        printf("FOUT interntabel groeide met %zu teksten\n", intern_aantal() - namen);
+        fouten++;
+    }
+    flut_omgeving_vrij(omgeving);
+    flut_programma_vrij(programma);
+
+    const char kapot[] = "x = \"\xC3(\";";
+    FILE *stil = fopen("/dev/null", "w");
+    if (flut_compileer(kapot, sizeof(kapot) - 1, true, stil, geheugen) != NULL) {
+        printf("FOUT ongeldige UTF-8 gecompileerd\n");
+        fouten++;
+    }
+
+    // de tweede regel kan niet geparset worden, dan ook de derde niet uitvoeren
+    const char syntaxfout[] = "a = 1;\nb = = 2;\nc = 3;\n";
+    char melding[128] = "";
+    FILE *meldingen = fmemopen(melding, sizeof(melding), "w");
+    if (flut_compileer(syntaxfout, sizeof(syntaxfout) - 1, false, meldingen, geheugen) != NULL) {
+        printf("FOUT syntaxfout gecompileerd\n");
+        fouten++;
+    }
+    fclose(meldingen);
+    if (strstr(melding, "regel 2") == NULL) {
+        printf("FOUT melding zonder regel: %s\n", melding);
+        fouten++;
+    }
+    fclose(stil);
+
+    GEHEUGEN_STAND totaal = flut_geheugen_stand(geheugen, GEHEUGEN_SOORTEN);
+    // de allocator zelf komt ook uit tel_bron
+    flut_geheugen_sluit(geheugen);
+    if (open_blokken != 0 || totaal.live != 0 || totaal.piek == 0) {
+        printf("FOUT %zu blokken en %llu bytes niet vrijgegeven\n", open_blokken, (unsigned long long)totaal.live);
+        fouten++;
+    }
+
+    printf("%s\n", fouten == 0 ? "OK" : "MISLUKT");
+    return fouten == 0 ? 0 : 1;
+}
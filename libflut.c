@@ -0,0 +1,139 @@
+#include "libflut.h"
+#include "flat.h"
+#include "geheugen.h"
+#include "intern.h"
+#include "lexer.h"
+#include "omgeving.h"
+#include "optimizer.h"
+#include "parser.h"
+#include "treewalker.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Alleen de platte boom wordt bewaard: één blok, en het uitvoeren loopt vooruit door het geheugen
+struct flut_programma {
+    FLAT_TREE boom;
+};
+
+FLUT_GEHEUGEN* flut_geheugen_nieuw(const GEHEUGEN_BRON *bron, void *data)
+{
+    return geheugen_nieuw(bron, data);
+}
+
+void flut_geheugen_sluit(FLUT_GEHEUGEN *geheugen)
+{
+    geheugen_sluit(geheugen);
+}
+
+GEHEUGEN_STAND flut_geheugen_stand(const FLUT_GEHEUGEN *geheugen, GEHEUGEN_SOORT soort)
+{
+    return geheugen_stand(geheugen, soort);
+}
+
+FLUT_PROGRAMMA* flut_compileer(const char *bron, size_t bron_size, bool utf8, FILE *meldingen, FLUT_GEHEUGEN *geheugen)
+{
+    OMGEVING omgeving;
+    omgeving_init(&omgeving, meldingen != NULL ? meldingen : stderr, geheugen);
+
+    // voor de regel van een syntaxfout
+    LEX_POSITIES posities;
+    lex_posities_init(&posities, geheugen);
+
+    LEX_STROOM stream;
+    lex_open_mem(&stream, bron, bron_size);
+    stream.utf8 = utf8;
+    stream.posities = &posities;
+
+    PARSER_NODE_BODY *body = parser_stream(&omgeving, &stream);
+
+    // de parser stopt bij het eerste statement dat niet lukt; dan is er een symbool over
+    bool volledig = lex_peek(&stream, 0)->type == LEX_SYM_EINDE;
+    size_t fout = stream.index;
+
+    // net als de driver: de rest lexen om ongeldige UTF-8 verderop te vinden
+    while (lex_next(&stream).type != LEX_SYM_EINDE) {
+    }
+    lex_sluit(&stream);
+    omgeving_vrij(&omgeving);
+
+    if (stream.ongeldig) {
+        fprintf(omgeving.uit, "Ongeldige UTF-8 op regel %zu (byte %zu)\n", stream.regel, stream.geldig);
+        parser_free(body);
+        lex_posities_vrij(&posities);
+        return NULL;
+    }
+    if (!volledig) {
+        size_t regel, kolom;
+        lex_positie(&posities, posities.symbolen[fout], &regel, &kolom);
+        fprintf(omgeving.uit, "Syntaxfout op regel %zu (kolom %zu)\n", regel, kolom);
+        parser_free(body);
+        lex_posities_vrij(&posities);
+        return NULL;
+    }
+    lex_posities_vrij(&posities);
+
+    // een keer compileren, vaak uitvoeren: dat is waar optimaliseren loont
+    optimize(body, NULL);
+
+    FLUT_PROGRAMMA *programma = geheugen_alloc(geheugen, GEHEUGEN_OVERIG, sizeof(FLUT_PROGRAMMA));
+    flat_build(&programma->boom, body, geheugen);
+    parser_free(body);
+    return programma;
+}
+
+void flut_programma_vrij(FLUT_PROGRAMMA *programma)
+{
+    if (programma != NULL) {
+        flat_free(&programma->boom);
+        geheugen_vrij(programma);
+    }
+}
+
+FLUT_OMGEVING* flut_omgeving_nieuw(FILE *uit, FLUT_GEHEUGEN *geheugen)
+{
+    FLUT_OMGEVING *omgeving = geheugen_alloc(geheugen, GEHEUGEN_OVERIG, sizeof(FLUT_OMGEVING));
+    omgeving_init(omgeving, uit != NULL ? uit : stderr, geheugen);
+    return omgeving;
+}
+
+void flut_omgeving_leeg(FLUT_OMGEVING *omgeving)
+{
+    omgeving_vrij(omgeving);
+}
+
+void flut_omgeving_vrij(FLUT_OMGEVING *omgeving)
+{
+    if (omgeving != NULL) {
+        omgeving_vrij(omgeving);
+        geheugen_vrij(omgeving);
+    }
+}
+
+void flut_zet_getal(FLUT_OMGEVING *omgeving, const char *naam, uint32_t waarde)
+{
+    set_num_variable(omgeving, intern_atoom(naam, strlen(naam)), waarde);
+}
+
+void flut_zet_tekst(FLUT_OMGEVING *omgeving, const char *naam, const char *tekst, size_t lengte)
+{
+    // per verzoek een andere tekst: die hoort niet in de interntabel, die groeit alleen maar
+    set_host_str_variable(omgeving, intern_atoom(naam, strlen(naam)), tekst, lengte);
+}
+
+// Een naam die nooit in de interntabel kwam is ook nooit een variabele geweest
+bool flut_lees_getal(const FLUT_OMGEVING *omgeving, const char *naam, uint32_t *waarde)
+{
+    INTERN_ATOOM atoom;
+    return intern_zoek(naam, strlen(naam), &atoom) && get_num_variable(omgeving, atoom, waarde);
+}
+
+bool flut_lees_tekst(const FLUT_OMGEVING *omgeving, const char *naam, const char **tekst, size_t *lengte)
+{
+    INTERN_ATOOM atoom;
+    return intern_zoek(naam, strlen(naam), &atoom) && get_str_variable(omgeving, atoom, tekst, lengte);
+}
+
+void flut_voer_uit(const FLUT_PROGRAMMA *programma, FLUT_OMGEVING *omgeving)
+{
+    treewalk_flat(omgeving, &programma->boom);
+}
@@ -0,0 +1,81 @@
+#ifndef LIBFLUT_H
+#define LIBFLUT_H
+
+#include "geheugen.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * libflut: flut inbedden in een ander programma. Een script wordt één keer
+ * gecompileerd (gelext, geparset en geoptimaliseerd) tot een programma, dat
+ * daarna zo vaak als nodig uitgevoerd wordt. Een programma verandert niet
+ * meer na flut_compileer en mag tegelijk in meerdere threads draaien, elk
+ * met een eigen omgeving.
+ *
+ * De omgeving bevat de variabelen. De host kan er vóór het uitvoeren
+ * variabelen in zetten als invoer en ze daarna uitlezen. Een omgeving kan
+ * voor het volgende verzoek leeggemaakt of met inhoud en al hergebruikt
+ * worden.
+ *
+ * Programma en omgeving krijgen hun geheugen uit een allocator van de host
+ * (flut_geheugen_nieuw op een eigen bron zoals een pool of arena, zie
+ * geheugen.h); NULL is gewoon malloc.
+ *
+ * libflut.so exporteert alleen de functies hieronder (FLUT_API); de rest van
+ * flut, ook de geheugen_*-functies, is alleen te gebruiken via libflut.a.
+ */
+
+#if defined(__GNUC__)
+#define FLUT_API __attribute__((visibility("default")))
+#else
+#define FLUT_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct flut_programma FLUT_PROGRAMMA;
+typedef struct omgeving FLUT_OMGEVING;
+typedef struct geheugen FLUT_GEHEUGEN;
+
+// Een allocator op bron (NULL: malloc), met alle tellers op nul
+FLUT_API FLUT_GEHEUGEN* flut_geheugen_nieuw(const GEHEUGEN_BRON *bron, void *data);
+// Pas als alle programma's en omgevingen erop vrijgegeven zijn
+FLUT_API void flut_geheugen_sluit(FLUT_GEHEUGEN *geheugen);
+// soort GEHEUGEN_SOORTEN geeft het totaal over alle soorten
+FLUT_API GEHEUGEN_STAND flut_geheugen_stand(const FLUT_GEHEUGEN *geheugen, GEHEUGEN_SOORT soort);
+
+// NULL bij ongeldige UTF-8 of een syntaxfout, nooit een half programma; meldingen gaan naar meldingen (NULL: stderr)
+FLUT_API FLUT_PROGRAMMA* flut_compileer(const char *bron, size_t bron_size, bool utf8, FILE *meldingen, FLUT_GEHEUGEN *geheugen);
+FLUT_API void flut_programma_vrij(FLUT_PROGRAMMA *programma);
+
+// Meldingen van de interpreter gaan naar uit (NULL: stderr)
+FLUT_API FLUT_OMGEVING* flut_omgeving_nieuw(FILE *uit, FLUT_GEHEUGEN *geheugen);
+// Vergeet alle variabelen en geeft de teksten van flut_zet_tekst vrij
+FLUT_API void flut_omgeving_leeg(FLUT_OMGEVING *omgeving);
+FLUT_API void flut_omgeving_vrij(FLUT_OMGEVING *omgeving);
+
+/*
+ * Namen van variabelen komen net als alles uit scripts in de interntabel,
+ * die blijft bestaan zolang het proces draait: gebruik een vaste set namen,
+ * niet per verzoek een nieuwe. Een tekst wordt gekopieerd in het geheugen
+ * van de omgeving en is weer vrij als de variabele verandert of de omgeving
+ * leeggemaakt of vrijgegeven wordt.
+ */
+FLUT_API void flut_zet_getal(FLUT_OMGEVING *omgeving, const char *naam, uint32_t waarde);
+FLUT_API void flut_zet_tekst(FLUT_OMGEVING *omgeving, const char *naam, const char *tekst, size_t lengte);
+// false als de variabele niet bestaat of een ander type heeft; lezen voegt niets toe aan de interntabel
+FLUT_API bool flut_lees_getal(const FLUT_OMGEVING *omgeving, const char *naam, uint32_t *waarde);
+// tekst eindigt op een nul en blijft geldig tot de variabele verandert of de omgeving leeggemaakt of vrijgegeven wordt
+FLUT_API bool flut_lees_tekst(const FLUT_OMGEVING *omgeving, const char *naam, const char **tekst, size_t *lengte);
+
+FLUT_API void flut_voer_uit(const FLUT_PROGRAMMA *programma, FLUT_OMGEVING *omgeving);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
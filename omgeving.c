@@ -0,0 +1,24 @@
+#include "omgeving.h"
+#include <stdlib.h>
+
+void omgeving_init(OMGEVING *omgeving, FILE *uit, GEHEUGEN *geheugen)
+{
+    omgeving->uit = uit;
+    omgeving->geheugen = geheugen != NULL ? geheugen : &geheugen_standaard;
+    omgeving->delen = false;
+    omgeving->gedeeld = 0;
+    omgeving->vars = NULL;
+    omgeving->vars_size = 0;
+}
+
+void omgeving_vrij(OMGEVING *omgeving)
+{
+    for (size_t i = 0; i < omgeving->vars_size; i++) {
+        if (omgeving->vars[i].type == VARIABLE_TYPE_HOST_STR) {
+            geheugen_vrij(omgeving->vars[i].host_str.text);
+        }
+    }
+    geheugen_vrij(omgeving->vars);
+    omgeving->vars = NULL;
+    omgeving->vars_size = 0;
+}
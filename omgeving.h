@@ -0,0 +1,60 @@
+#ifndef OMGEVING_H
+#define OMGEVING_H
+
+#include "geheugen.h"
+#include "intern.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Alles wat bij één uitvoering van een programma hoort. Parser en treewalker
+ * krijgen er een mee in plaats van globale toestand te gebruiken; wat
+ * gedeeld wordt (de grammatica, de interntabel) wordt alleen gelezen of is
+ * zelf thread-safe. Zo kunnen meerdere threads elk met een eigen omgeving
+ * tegelijk programma's uitvoeren.
+ */
+typedef enum {
+    VARIABLE_TYPE_NONE,
+    VARIABLE_TYPE_NUM,
+    VARIABLE_TYPE_STR,
+    // tekst van de host: een eigen kopie uit omgeving->geheugen, weg met de variabele
+    VARIABLE_TYPE_HOST_STR,
+} VARIABLE_TYPE;
+
+typedef struct variable {
+    INTERN_ATOOM identifier;
+    VARIABLE_TYPE type;
+    union {
+        uint32_t number;
+        INTERN_ATOOM str;
+        struct {
+            char *text;
+            size_t size;
+        } host_str;
+    };
+} VARIABLE;
+
+typedef struct omgeving {
+    // meldingen van parser en treewalker en de dumps
+    FILE *uit;
+
+    // voor de syntaxboom van de parser en de variabelen
+    GEHEUGEN *geheugen;
+
+    // gelijke expressies in de parser maar één keer in de boom (hash-consing), en hoe vaak een knoop hergebruikt werd
+    bool delen;
+    uint64_t gedeeld;
+
+    // variabelen van het programma, alleen de treewalker kijkt erin
+    VARIABLE *vars;
+    size_t vars_size;
+} OMGEVING;
+
+// geheugen NULL: geheugen_standaard
+void omgeving_init(OMGEVING *omgeving, FILE *uit, GEHEUGEN *geheugen);
+// Geeft de variabelen vrij; daarna kan de omgeving opnieuw gebruikt worden
+void omgeving_vrij(OMGEVING *omgeving);
+
+#endif
@@ -0,0 +1,210 @@
+#include "optimizer.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+static const char *pass_names[OPTIMIZER_PASSES] = {
+    "fold",
+    "identities",
+    "dead branches",
+};
+
+// Rewrites the expression in *slot and returns the number of nodes removed
+typedef size_t (*REWRITE)(PARSER_NODE **slot);
+
+static bool is_number(const PARSER_NODE *node)
+{
+    return node->type == PARSER_TYPE_LITERAL && node->literal == PARSER_LITERAL_NUMBER;
+}
+
+static bool is_number_equal(const PARSER_NODE *node, uint32_t number)
+{
+    return is_number(node) && node->number == number;
+}
+
+static size_t fold(PARSER_NODE **slot)
+{
+    PARSER_NODE *node = *slot;
+    if (node->type != PARSER_TYPE_OPERATOR) {
+        return 0;
+    }
+
+    size_t removed = fold(&node->left) + fold(&node->right);
+    if (!is_number(node->left) || !is_number(node->right)) {
+        return removed;
+    }
+
+    // the same uint32_t arithmetic as execute_operator
+    uint32_t left = node->left->number;
+    uint32_t right = node->right->number;
+    uint32_t result;
+    switch (node->operator) {
+        case PARSER_OPERATOR_ADD:
+            result = left + right;
+            break;
+        case PARSER_OPERATOR_SUBTRACT:
+            result = left - right;
+            break;
+        case PARSER_OPERATOR_MULTIPLY:
+            result = left * right;
+            break;
+        case PARSER_OPERATOR_DIVIDE:
+            // stays a runtime error
+            if (right == 0) {
+                return removed;
+            }
+            result = left / right;
+            break;
+        default:
+            // the treewalker reports the comparisons as unsupported, so it has to see them
+            return removed;
+    }
+
+    node->type = PARSER_TYPE_LITERAL;
+    node->literal = PARSER_LITERAL_NUMBER;
+    node->number = result;
+    node->left = NULL;
+    node->right = NULL;
+    return removed + 2;
+}
+
+static size_t identities(PARSER_NODE **slot)
+{
+    PARSER_NODE *node = *slot;
+    if (node->type != PARSER_TYPE_OPERATOR) {
+        return 0;
+    }
+
+    size_t removed = identities(&node->left) + identities(&node->right);
+    PARSER_NODE *keep = NULL;
+    switch (node->operator) {
+        case PARSER_OPERATOR_ADD:
+            keep = is_number_equal(node->right, 0) ? node->left : is_number_equal(node->left, 0) ? node->right : NULL;
+            break;
+        case PARSER_OPERATOR_SUBTRACT:
+            keep = is_number_equal(node->right, 0) ? node->left : NULL;
+            break;
+        case PARSER_OPERATOR_MULTIPLY:
+            keep = is_number_equal(node->right, 1) ? node->left : is_number_equal(node->left, 1) ? node->right : NULL;
+            break;
+        case PARSER_OPERATOR_DIVIDE:
+            keep = is_number_equal(node->right, 1) ? node->left : NULL;
+            break;
+        default:
+            break;
+    }
+
+    /*
+     * Only an operator means the same on its own as below another one: a
+     * string below an operator is an error, but assigned directly it is a
+     * string. x * 0 is left alone, x may still fail or print something.
+     */
+    if (keep == NULL || keep->type != PARSER_TYPE_OPERATOR) {
+        return removed;
+    }
+    *slot = keep;
+    return removed + 2;
+}
+
+static size_t rewrite_body(PARSER_NODE_BODY *body, REWRITE rewrite);
+
+// Applies rewrite to every expression in the statement
+static size_t rewrite_statement(PARSER_NODE *node, REWRITE rewrite)
+{
+    if (node == NULL) {
+        return 0;
+    }
+
+    switch (node->type) {
+        case PARSER_TYPE_ASSIGNMENT:
+            return node->right != NULL ? rewrite(&node->right) : 0;
+        case PARSER_TYPE_CONDITIONAL:
+            return rewrite(&node->expression) + rewrite_statement(node->left, rewrite) + rewrite_statement(node->right, rewrite);
+        case PARSER_TYPE_BODY:
+            return rewrite_body(&node->body, rewrite);
+        default:
+            return 0;
+    }
+}
+
+static size_t rewrite_body(PARSER_NODE_BODY *body, REWRITE rewrite)
+{
+    size_t removed = 0;
+    for (size_t i = 0; i < body->expressions_size; i++) {
+        removed += rewrite_statement(body->expressions[i], rewrite);
+    }
+    return removed;
+}
+
+static size_t fold_body(PARSER_NODE_BODY *body)
+{
+    return rewrite_body(body, fold);
+}
+
+static size_t identities_body(PARSER_NODE_BODY *body)
+{
+    return rewrite_body(body, identities);
+}
+
+static size_t dead_branches_body(PARSER_NODE_BODY *body);
+
+// Sets *slot to NULL when the statement disappears altogether
+static size_t dead_branches(PARSER_NODE **slot)
+{
+    PARSER_NODE *node = *slot;
+    if (node == NULL) {
+        return 0;
+    }
+    if (node->type == PARSER_TYPE_BODY) {
+        return dead_branches_body(&node->body);
+    }
+    if (node->type != PARSER_TYPE_CONDITIONAL) {
+        return 0;
+    }
+
+    size_t removed = dead_branches(&node->left) + dead_branches(&node->right);
+    if (node->expression->type != PARSER_TYPE_LITERAL) {
+        return removed;
+    }
+
+    // like the treewalker: a number is its value, any other literal counts as 0
+    PARSER_NODE *branch = is_number(node->expression) && node->expression->number != 0 ? node->right : node->left;
+    removed += parser_subtree_count(node) - parser_subtree_count(branch);
+    *slot = branch;
+    return removed;
+}
+
+static size_t dead_branches_body(PARSER_NODE_BODY *body)
+{
+    size_t removed = 0;
+    size_t kept = 0;
+    for (size_t i = 0; i < body->expressions_size; i++) {
+        removed += dead_branches(&body->expressions[i]);
+        if (body->expressions[i] != NULL) {
+            body->expressions[kept++] = body->expressions[i];
+        }
+    }
+    body->expressions_size = kept;
+    return removed;
+}
+
+// Folding first leaves literals for the other two to find
+static size_t (*const passes[OPTIMIZER_PASSES])(PARSER_NODE_BODY *body) = {
+    [OPTIMIZER_FOLD] = fold_body,
+    [OPTIMIZER_IDENTITIES] = identities_body,
+    [OPTIMIZER_DEAD_BRANCHES] = dead_branches_body,
+};
+
+void optimize(PARSER_NODE_BODY *body, OPTIMIZER_REPORT *report)
+{
+    for (int pass = 0; pass < OPTIMIZER_PASSES; pass++) {
+        size_t removed = passes[pass](body);
+        if (report != NULL) {
+            report->removed[pass] = removed;
+        }
+    }
+}
+
+const char* optimizer_pass_name(OPTIMIZER_PASS pass)
+{
+    return pass < OPTIMIZER_PASSES ? pass_names[pass] : "";
+}
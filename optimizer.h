@@ -0,0 +1,34 @@
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+#include <stddef.h>
+#include "parser.h"
+
+/*
+ * Passes over the syntax tree between parser() and treewalk(). Each pass
+ * rewrites the tree in place and keeps what the program does exactly the
+ * same, diagnostics included: anything the treewalker would complain about
+ * or fail on, like a division by zero, is left for it to run into.
+ *
+ * Removed nodes stay in the parser's arena until parser_free.
+ */
+
+typedef enum {
+    // operators with only number literals below them become one literal
+    OPTIMIZER_FOLD,
+    // x + 0, x * 1 and friends become x
+    OPTIMIZER_IDENTITIES,
+    // conditionals on a literal become their body, or nothing
+    OPTIMIZER_DEAD_BRANCHES,
+    OPTIMIZER_PASSES,
+} OPTIMIZER_PASS;
+
+typedef struct {
+    // nodes each pass removed from the tree
+    size_t removed[OPTIMIZER_PASSES];
+} OPTIMIZER_REPORT;
+
+// Runs every pass in order; report may be NULL
+void optimize(PARSER_NODE_BODY *body, OPTIMIZER_REPORT *report);
+const char* optimizer_pass_name(OPTIMIZER_PASS pass);
+
+#endif
@@ -1,6 +1,325 @@
+#define _POSIX_C_SOURCE 200809L
+#include "geheugen.h"
+#include "lexer.h"
+#include "omgeving.h"
+#include "parser.h"
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
-int main()
+/*
+ * Benchmark voor lexer en parser. Maakt voor elk soort programma en elke
+ * grootte van 1 KB tot MAX_MB (standaard 100 MB) een synthetisch programma,
+ * altijd hetzelfde, en meet lex_parse_mem (MB/s, symbolen/s) en parser
+ * (knopen/s), met het aantal allocaties en de piek van elke fase. De parser
+ * wordt gemeten op één thread en met parser_parallel op alle processors; die
+ * moet evenveel knopen opleveren, ook als het programma in PARALLEL_STUKKEN
+ * stukken gesplitst wordt. Dat geldt ook voor de boom met gedeelde knopen
+ * (omgeving.delen), waarvan de piek apart staat.
+ *
+ * Lexen en parsen horen lineair te zijn: vanaf 100 KB, waar vaste kosten
+ * niet meer tellen, wordt elke grootte waarbij de tijd per byte meer dan
+ * SCHAAL_MARGE keer zo groot is als bij de vorige gemarkeerd. Dan is de
+ * exitcode 1.
+ *
+ * Gebruik: parser-test [MAX_MB]
+ */
+
+#define SCHAAL_MARGE 2.0
+#define SCHAAL_VANAF (100 * 1024)
+// Kleine invoer wordt herhaald tot er minstens zo lang gemeten is
+#define MIN_MEETTIJD_MS 50.0
+// Zoveel threads voor de controle van parser_parallel, ook op een machine met minder processors
+#define PARALLEL_STUKKEN 4
+
+static uint32_t willekeurig_staat;
+
+static uint32_t willekeurig(void)
+{
+    willekeurig_staat = willekeurig_staat * 1103515245 + 12345;
+    return willekeurig_staat >> 8;
+}
+
+typedef struct {
+    char *buf;
+    size_t size;
+    size_t allocated;
+} TEKST;
+
+static void schrijf(TEKST *t, const char *fmt, ...)
+{
+    va_list args;
+    for (;;) {
+        va_start(args, fmt);
+        int n = vsnprintf(t->buf + t->size, t->allocated - t->size, fmt, args);
+        va_end(args);
+        if ((size_t)n < t->allocated - t->size) {
+            t->size += n;
+            return;
+        }
+        t->allocated = t->allocated * 2 + n + 1;
+        t->buf = realloc(t->buf, t->allocated);
+    }
+}
+
+static const char *operatoren[] = { "+", "-", "*", "/", "==", "!=", "<", "<=", ">", ">=" };
+
+static void expressie(TEKST *t, size_t termen)
+{
+    schrijf(t, "%u", willekeurig() % 1000);
+    for (size_t i = 1; i < termen; i++) {
+        const char *op = operatoren[willekeurig() % (sizeof(operatoren) / sizeof(operatoren[0]))];
+        schrijf(t, " %s %s%u", op, willekeurig() % 8 == 0 ? "-" : "", willekeurig() % 1000 + 1);
+    }
+}
+
+// Lange ketens van operatoren met alle voorrangsniveaus door elkaar
+static void maak_diep(TEKST *t, size_t size)
+{
+    while (t->size < size) {
+        schrijf(t, "d%u = ", willekeurig() % 16);
+        expressie(t, 50 + willekeurig() % 150);
+        schrijf(t, ";\n");
+    }
+}
+
+// Heel veel korte statements
+static void maak_lang(TEKST *t, size_t size)
+{
+    while (t->size < size) {
+        schrijf(t, "a%u = ", willekeurig() % 16);
+        expressie(t, 1 + willekeurig() % 3);
+        schrijf(t, ";\n");
+    }
+}
+
+// Een toren van 64 geneste als-blokken, elk met een deel van de statements vóór het volgende blok
+static void maak_als(TEKST *t, size_t size)
+{
+    const int diepte = 64;
+    for (int niveau = 0; niveau < diepte; niveau++) {
+        size_t tot = size * (niveau + 1) / diepte;
+        while (t->size < tot) {
+            schrijf(t, "%*sb%u = ", niveau * 2, "", willekeurig() % 16);
+            expressie(t, 1 + willekeurig() % 5);
+            schrijf(t, ";\n");
+        }
+        schrijf(t, "%*sals %u {\n", niveau * 2, "", willekeurig() % 2);
+    }
+    for (int niveau = diepte - 1; niveau >= 0; niveau--) {
+        schrijf(t, "%*s}\n", niveau * 2, "");
+    }
+}
+
+// Tekenreeksen van 100 bytes tot 64 KB (of wat er nog past), ook met escapes
+static void maak_teksten(TEKST *t, size_t size)
+{
+    while (t->size < size) {
+        size_t lengte = 100 + willekeurig() % (64 * 1024);
+        if (lengte > size - t->size) {
+            lengte = size - t->size > 100 ? size - t->size : 100;
+        }
+        schrijf(t, "s%u = \"", willekeurig() % 16);
+        for (size_t i = 0; i < lengte; i++) {
+            uint32_t r = willekeurig() % 64;
+            schrijf(t, "%s", r == 0 ? "\\\"" : r == 1 ? "\\\\" : r < 8 ? " " : "x");
+        }
+        schrijf(t, "\";\n");
+    }
+}
+
+// Zoveel verschillende namen als er statements zijn, zodat de interntabel groeit
+static void maak_namen(TEKST *t, size_t size)
+{
+    uint32_t n = 0;
+    while (t->size < size) {
+        schrijf(t, "naam_%u_%x = %u;\n", n, willekeurig(), n);
+        n++;
+    }
+}
+
+typedef struct {
+    const char *naam;
+    void (*maak)(TEKST *t, size_t size);
+} GENERATOR;
+
+static const GENERATOR generatoren[] = {
+    { "diepe expressies", maak_diep },
+    { "lange statementlijsten", maak_lang },
+    { "geneste als-blokken", maak_als },
+    { "lange tekenreeksen", maak_teksten },
+    { "veel namen", maak_namen },
+};
+
+static double nu_ms(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e3 + t.tv_nsec / 1e6;
+}
+
+typedef struct {
+    double lex_ms;
+    double parse_ms;
+    double parallel_ms;
+    size_t symbolen;
+    size_t knopen;
+    size_t parallel_knopen;
+    uint64_t lex_allocaties;
+    uint64_t parse_allocaties;
+    uint64_t lex_piek;
+    uint64_t parse_piek;
+    size_t delen_knopen;
+    uint64_t delen_piek;
+} METING;
+
+// Eén keer lexen en parsen, elk met een eigen allocator zodat de tellers per fase kloppen
+static void meet_een_keer(const TEKST *t, METING *m, FILE *stil)
 {
+    GEHEUGEN *lex_geheugen = geheugen_nieuw(&geheugen_malloc, NULL);
+    double begin = nu_ms();
+    size_t symbolen_size;
+    LEX_SYMBOL *symbolen = lex_parse_mem(t->buf, t->size, &symbolen_size, NULL, false, lex_geheugen);
+    m->lex_ms += nu_ms() - begin;
+
+    GEHEUGEN *parse_geheugen = geheugen_nieuw(&geheugen_malloc, NULL);
+    OMGEVING omgeving;
+    omgeving_init(&omgeving, stil, parse_geheugen);
+    begin = nu_ms();
+    PARSER_NODE_BODY *body = parser_parallel(&omgeving, symbolen, symbolen_size, 1);
+    m->parse_ms += nu_ms() - begin;
+
+    m->symbolen = symbolen_size;
+    m->knopen = parser_node_count(body);
+    m->lex_allocaties = geheugen_stand(lex_geheugen, GEHEUGEN_SOORTEN).allocaties;
+    m->lex_piek = geheugen_stand(lex_geheugen, GEHEUGEN_SOORTEN).piek;
+    m->parse_allocaties = geheugen_stand(parse_geheugen, GEHEUGEN_SOORTEN).allocaties;
+    m->parse_piek = geheugen_stand(parse_geheugen, GEHEUGEN_SOORTEN).piek;
+
+    parser_free(body);
+
+    // na de tellers, die gaan alleen over het parsen op één thread
+    begin = nu_ms();
+    body = parser_parallel(&omgeving, symbolen, symbolen_size, 0);
+    m->parallel_ms += nu_ms() - begin;
+    parser_free(body);
+
+    body = parser_parallel(&omgeving, symbolen, symbolen_size, PARALLEL_STUKKEN);
+    m->parallel_knopen = parser_node_count(body);
+    parser_free(body);
+
+    GEHEUGEN *delen_geheugen = geheugen_nieuw(&geheugen_malloc, NULL);
+    OMGEVING delen;
+    omgeving_init(&delen, stil, delen_geheugen);
+    delen.delen = true;
+    body = parser_parallel(&delen, symbolen, symbolen_size, 1);
+    m->delen_knopen = parser_node_count(body);
+    m->delen_piek = geheugen_stand(delen_geheugen, GEHEUGEN_SOORTEN).piek;
+    parser_free(body);
+    omgeving_vrij(&delen);
+    geheugen_sluit(delen_geheugen);
+
+    geheugen_vrij(symbolen);
+    omgeving_vrij(&omgeving);
+    geheugen_sluit(lex_geheugen);
+    geheugen_sluit(parse_geheugen);
+}
+
+static void meet(const TEKST *t, METING *m, FILE *stil)
+{
+    memset(m, 0, sizeof(METING));
+    int keer = 0;
+    do {
+        meet_een_keer(t, m, stil);
+        keer++;
+    } while (m->lex_ms + m->parse_ms < MIN_MEETTIJD_MS);
+    m->lex_ms /= keer;
+    m->parse_ms /= keer;
+    m->parallel_ms /= keer;
+}
+
+static void print_grootte(size_t bytes)
+{
+    if (bytes >= 1024 * 1024) {
+        printf("%7.1f MB", bytes / (1024.0 * 1024.0));
+    } else {
+        printf("%7.1f KB", bytes / 1024.0);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t max = (argc > 1 ? strtoull(argv[1], NULL, 10) : 100) * 1024 * 1024;
+    if (max == 0) {
+        fprintf(stderr, "Gebruik: %s [MAX_MB]\n", argv[0]);
+        return 1;
+    }
+
+    // de parser meldt hier niets, maar zou anders tussen de tabel door komen
+    FILE *stil = fopen("/dev/null", "w");
+    int niet_lineair = 0;
+    int fouten = 0;
+
+    for (size_t g = 0; g < sizeof(generatoren) / sizeof(generatoren[0]); g++) {
+        printf("%s\n", generatoren[g].naam);
+        printf("  %10s %10s %12s %10s %12s %13s %10s %11s %12s %12s %12s %8s\n",
+            "grootte", "lex MB/s", "symbolen/s", "parse MB/s", "knopen/s", "parallel MB/s",
+            "lex alloc", "parse alloc", "lex piek", "parse piek", "delen piek", "ns/byte");
+
+        double vorige_ns_per_byte = 0;
+        for (size_t size = 1024; size <= max; size *= 10) {
+            willekeurig_staat = 12345 + (uint32_t)g;
+            TEKST t = { 0 };
+            generatoren[g].maak(&t, size);
+
+            METING m;
+            meet(&t, &m, stil);
+
+            double mb = t.size / (1024.0 * 1024.0);
+            double ns_per_byte = (m.lex_ms + m.parse_ms) * 1e6 / t.size;
+            printf("  ");
+            print_grootte(t.size);
+            printf(" %10.1f %12.3g %10.1f %12.3g %13.1f %10" PRIu64 " %11" PRIu64 " %12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %8.2f",
+                mb / (m.lex_ms / 1e3), m.symbolen / (m.lex_ms / 1e3),
+                mb / (m.parse_ms / 1e3), m.knopen / (m.parse_ms / 1e3), mb / (m.parallel_ms / 1e3),
+                m.lex_allocaties, m.parse_allocaties, m.lex_piek, m.parse_piek, m.delen_piek, ns_per_byte);
+
+            if (t.size >= SCHAAL_VANAF && vorige_ns_per_byte > 0 && ns_per_byte > vorige_ns_per_byte * SCHAAL_MARGE) {
+                printf("  <- niet lineair (%.1fx per byte)", ns_per_byte / vorige_ns_per_byte);
+                niet_lineair++;
+            }
+            if (m.parallel_knopen != m.knopen) {
+                printf("  <- parallel %zu knopen", m.parallel_knopen);
+                fouten++;
+            }
+            if (m.delen_knopen != m.knopen) {
+                printf("  <- gedeeld %zu knopen", m.delen_knopen);
+                fouten++;
+            }
+            printf("\n");
+            fflush(stdout);
+
+            vorige_ns_per_byte = ns_per_byte;
+            free(t.buf);
+        }
+    }
+    fclose(stil);
 
+    if (fouten > 0) {
+        printf("%d keer een andere boom met parser_parallel of gedeelde knopen\n", fouten);
+    }
+    if (niet_lineair > 0) {
+        printf("%d keer niet lineair\n", niet_lineair);
+    }
+    if (fouten > 0 || niet_lineair > 0) {
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
 }
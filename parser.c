@@ -1,13 +1,18 @@
+#define _POSIX_C_SOURCE 200809L
 #include "parser.h"
+#include "arena.h"
+#include "geheugen.h"
 #include "lexer.h"
 
 #include <inttypes.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 typedef enum {
     RULE_TYPE_TERMINAL,
@@ -28,11 +33,41 @@ typedef enum {
     PRIORITY_NONE,
 } PRIORITY;
 
+// A parsed program: the root body and the arena holding every node of it
+struct parser_tree {
+    PARSER_NODE_BODY body;
+    ARENA arena;
+};
+
+// State of a single parse; the grammar itself is shared by all of them
+typedef struct {
+    LEX_STROOM *stream;
+    OMGEVING *omgeving;
+    ARENA *arena;
+
+    // nesting of the bodies being parsed; 1 is the program itself
+    int depth;
+    // if not NULL: the stream index after each top-level statement, for parser_statements
+    size_t *ends;
+    // the stream index after the last top-level statement
+    size_t parsed;
+
+    // with omgeving->delen: open addressing table of every expression node so far, shared_allocated is a power of two
+    PARSER_NODE **shared;
+    size_t shared_size;
+    size_t shared_allocated;
+
+    // statements of the bodies being parsed, innermost last; copied into the arena when a body is done
+    PARSER_NODE **pending;
+    size_t pending_size;
+    size_t pending_allocated;
+} PARSER;
+
 struct rule {
     RULE_TYPE type;
     LEX_SYMBOOL_TYPE symbol;
     REPEAT repeat;
-    PARSER_NODE* (*func)(LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index);
+    PARSER_NODE* (*func)(PARSER *p);
 
     PRIORITY priority;
     PARSER_TYPE node_type;
@@ -43,10 +78,16 @@ struct rule {
 
 struct rule* rule_create(RULE_TYPE type)
 {
-    struct rule *rule = malloc(sizeof(struct rule));
+    struct rule *rule = geheugen_alloc(NULL, GEHEUGEN_OVERIG, sizeof(struct rule));
     rule->type = type;
 
+    rule->symbol = LEX_SYM_ONBEKEND;
     rule->repeat = REPEAT_NONE;
+    rule->func = NULL;
+
+    // Groups are placed like a primary node
+    rule->priority = PRIORITY_PRIMARY;
+    rule->node_type = PARSER_TYPE_NONE;
 
     rule->group = NULL;
     rule->group_size = 0;
@@ -67,7 +108,7 @@ struct rule* rule_create_terminal(LEX_SYMBOOL_TYPE symbol, PRIORITY place, PARSE
     return rule;
 }
 
-struct rule* rule_create_non_terminal(PARSER_NODE* (*func)(LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index), PRIORITY priority)
+struct rule* rule_create_non_terminal(PARSER_NODE* (*func)(PARSER *p), PRIORITY priority)
 {
     struct rule *rule = rule_create(RULE_TYPE_NON_TERMINAL);
 
@@ -82,7 +123,7 @@ struct rule* rule_create_non_terminal(PARSER_NODE* (*func)(LEX_SYMBOL *symbols,
 struct rule* rule_add_to_group(struct rule* rule, struct rule* subrule)
 {
     rule->group_size += 1;
-    rule->group = realloc(rule->group, sizeof(struct rule*) * rule->group_size);
+    rule->group = geheugen_realloc(NULL, GEHEUGEN_OVERIG, rule->group, sizeof(struct rule*) * rule->group_size);
     rule->group[rule->group_size-1] = subrule;
 
     return subrule;
@@ -93,41 +134,22 @@ void rule_set_repeat(struct rule* rule, REPEAT repeat)
     rule->repeat = repeat;
 }
 
-PARSER_NODE* parse_expression(LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index);
-
-bool unimportant_symbol(LEX_SYMBOOL_TYPE symbol)
-{
-    switch (symbol) {
-        case LEX_SYM_SPATIE:
-        case LEX_SYM_REGEL:
-            return true;
-        default:
-            return false;
-    }
-}
+PARSER_NODE* parse_expression(PARSER *p);
 
-void skip_unimportant_symbols(LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index)
+static PARSER_NODE* node_create(PARSER *p)
 {
-    while (*symbols_index < symbols_size) {
-        if (unimportant_symbol(symbols[*symbols_index].type)) {
-            *symbols_index += 1;
-        } else {
-            return;
-        }
-    }
+    return arena_alloc(p->arena, sizeof(PARSER_NODE));
 }
 
-PARSER_NODE* lexer_symbol_to_node(PARSER_TYPE type, LEX_SYMBOL symbol)
+static void symbol_to_node(PARSER *p, PARSER_NODE *node, PARSER_TYPE type, LEX_SYMBOL symbol)
 {
-    PARSER_NODE *node = malloc(sizeof(PARSER_NODE));
     node->type = type;
     node->left = NULL;
     node->right = NULL;
 
     switch (node->type) {
         case PARSER_TYPE_IDENTIFIER:
-            node->identifier = malloc(strlen(symbol.tekenreeks) + 1);
-            strcpy(node->identifier, symbol.tekenreeks);
+            node->identifier = symbol.atoom;
             break;
         case PARSER_TYPE_OPERATOR:
             switch (symbol.type) {
@@ -162,7 +184,7 @@ PARSER_NODE* lexer_symbol_to_node(PARSER_TYPE type, LEX_SYMBOL symbol)
                     node->operator = PARSER_OPERATOR_HIGHER_THAN_EQUAL_TO;
                     break;
                 default:
-                    printf("Not an operator token!\n");
+                    fprintf(p->omgeving->uit, "Not an operator token!\n");
                     break;
             }
             break;
@@ -174,8 +196,7 @@ PARSER_NODE* lexer_symbol_to_node(PARSER_TYPE type, LEX_SYMBOL symbol)
                     break;
                 case LEX_SYM_TEKENREEKS:
                     node->literal = PARSER_LITERAL_STRING;
-                    node->string = malloc(strlen(symbol.tekenreeks) + 1);
-                    strcpy(node->string, symbol.tekenreeks);
+                    node->string = symbol.atoom;
                     break;
                 case LEX_SYM_ONWAAR:
                     node->literal = PARSER_LITERAL_BOOLEAN;
@@ -186,45 +207,147 @@ PARSER_NODE* lexer_symbol_to_node(PARSER_TYPE type, LEX_SYMBOL symbol)
                     node->boolean = true;
                     break;
                 default:
-                    printf("Not a literal!\n");
+                    fprintf(p->omgeving->uit, "Not a literal!\n");
                     break;
             }
             break;
         default:
             break;
     }
+}
+
+PARSER_NODE* lexer_symbol_to_node(PARSER *p, PARSER_TYPE type, LEX_SYMBOL symbol)
+{
+    PARSER_NODE *node = node_create(p);
+    symbol_to_node(p, node, type, symbol);
+    return node;
+}
+
+// What a shared node holds besides its type and children
+static uint64_t node_value(const PARSER_NODE *node)
+{
+    switch (node->type) {
+        case PARSER_TYPE_LITERAL:
+            switch (node->literal) {
+                case PARSER_LITERAL_NUMBER:
+                    return (uint64_t)PARSER_LITERAL_NUMBER << 32 | node->number;
+                case PARSER_LITERAL_STRING:
+                    return (uint64_t)PARSER_LITERAL_STRING << 32 | node->string;
+                case PARSER_LITERAL_BOOLEAN:
+                    return (uint64_t)PARSER_LITERAL_BOOLEAN << 32 | node->boolean;
+            }
+            return 0;
+        case PARSER_TYPE_IDENTIFIER:
+            return node->identifier;
+        case PARSER_TYPE_OPERATOR:
+            return node->operator;
+        default:
+            return 0;
+    }
+}
+
+static uint64_t node_hash(const PARSER_NODE *node)
+{
+    uint64_t h = (uint64_t)node->type * 0x9e3779b97f4a7c15u ^ node_value(node);
+    h = (h ^ (uintptr_t)node->left) * 0xff51afd7ed558ccdu;
+    h = (h ^ (uintptr_t)node->right) * 0xc4ceb9fe1a85ec53u;
+    return h ^ h >> 29;
+}
+
+static bool node_equal(const PARSER_NODE *a, const PARSER_NODE *b)
+{
+    return a->type == b->type && node_value(a) == node_value(b) && a->left == b->left && a->right == b->right;
+}
+
+static void shared_grow(PARSER *p)
+{
+    size_t allocated = p->shared_allocated == 0 ? 256 : p->shared_allocated * 2;
+    PARSER_NODE **shared = geheugen_nul(p->omgeving->geheugen, GEHEUGEN_BOOM, allocated, sizeof(PARSER_NODE*));
+    for (size_t i = 0; i < p->shared_allocated; i++) {
+        if (p->shared[i] != NULL) {
+            size_t slot = node_hash(p->shared[i]) & (allocated - 1);
+            while (shared[slot] != NULL) {
+                slot = (slot + 1) & (allocated - 1);
+            }
+            shared[slot] = p->shared[i];
+        }
+    }
+    geheugen_vrij(p->shared);
+    p->shared = shared;
+    p->shared_allocated = allocated;
+}
+
+/*
+ * Builds an expression node: a literal, a name or an operator over finished
+ * operands. With omgeving->delen an equal node built before is returned
+ * instead, so the tree is a DAG in which equal subexpressions are the same
+ * node. The operands are shared already, so comparing their addresses
+ * compares the whole subtree.
+ */
+static PARSER_NODE* expression_node(PARSER *p, PARSER_TYPE type, LEX_SYMBOL symbol, PARSER_NODE *left, PARSER_NODE *right)
+{
+    if (!p->omgeving->delen) {
+        PARSER_NODE *node = lexer_symbol_to_node(p, type, symbol);
+        node->left = left;
+        node->right = right;
+        return node;
+    }
 
+    PARSER_NODE candidate;
+    memset(&candidate, 0, sizeof(PARSER_NODE));
+    symbol_to_node(p, &candidate, type, symbol);
+    candidate.left = left;
+    candidate.right = right;
+
+    // at most half full
+    if ((p->shared_size + 1) * 2 > p->shared_allocated) {
+        shared_grow(p);
+    }
+    size_t slot = node_hash(&candidate) & (p->shared_allocated - 1);
+    while (p->shared[slot] != NULL) {
+        if (node_equal(p->shared[slot], &candidate)) {
+            p->omgeving->gedeeld++;
+            return p->shared[slot];
+        }
+        slot = (slot + 1) & (p->shared_allocated - 1);
+    }
+
+    PARSER_NODE *node = node_create(p);
+    *node = candidate;
+    p->shared[slot] = node;
+    p->shared_size++;
     return node;
 }
 
-PARSER_NODE* parse_rule(struct rule **rule, size_t rule_size, LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index)
+PARSER_NODE* parse_rule(struct rule **rule, size_t rule_size, PARSER *p)
 {
     PARSER_NODE *parent_node = NULL;
 
     size_t i = 0;
     while (i < rule_size) {
-        skip_unimportant_symbols(symbols, symbols_size, symbols_index);
-
         PARSER_NODE *node = NULL;
 
-        if (symbols[*symbols_index].type == LEX_SYM_PUNTKOMMA) {
-            *symbols_index += 1;
+        if (lex_peek(p->stream, 0)->type == LEX_SYM_PUNTKOMMA) {
+            lex_next(p->stream);
             break;
         }
 
         if (rule[i]->type == RULE_TYPE_TERMINAL) {
-            if (rule[i]->symbol == symbols[*symbols_index].type) {
-                if (rule[i]->node_type != PARSER_TYPE_NONE) {
+            if (rule[i]->symbol == lex_peek(p->stream, 0)->type) {
+                if (rule[i]->node_type == PARSER_TYPE_IDENTIFIER) {
+                    // a name is never changed once it is placed, so it can be shared
+                    node = expression_node(p, PARSER_TYPE_IDENTIFIER, *lex_peek(p->stream, 0), NULL, NULL);
+                } else if (rule[i]->node_type != PARSER_TYPE_NONE) {
                     // From lexer format to parser
-                    node = lexer_symbol_to_node(rule[i]->node_type, symbols[*symbols_index]);
+                    node = lexer_symbol_to_node(p, rule[i]->node_type, *lex_peek(p->stream, 0));
                 }
-                *symbols_index += 1;
+                lex_next(p->stream);
             }
         } else if (rule[i]->type == RULE_TYPE_NON_TERMINAL) {
             // Execute non-terminal
-            node = rule[i]->func(symbols, symbols_size, symbols_index);
+            node = rule[i]->func(p);
         } else if (rule[i]->type == RULE_TYPE_GROUP) {
-            node = parse_rule(rule[i]->group, rule[i]->group_size, symbols, symbols_size, symbols_index);
+            node = parse_rule(rule[i]->group, rule[i]->group_size, p);
         }
 
         // If not NULL, put it somewhere
@@ -245,7 +368,7 @@ PARSER_NODE* parse_rule(struct rule **rule, size_t rule_size, LEX_SYMBOL *symbol
                 parent_node->left = parent_node->right;
                 parent_node->right = node;
             } else { // No available spots in parent node
-                printf("hit!\n");
+                fprintf(p->omgeving->uit, "hit!\n");
             }
         } else { // Rule not true
             // check if a following rule is an or and if so go to the rule after
@@ -271,15 +394,7 @@ PARSER_NODE* parse_rule(struct rule **rule, size_t rule_size, LEX_SYMBOL *symbol
                 continue;
             }
 
-            if (parent_node != NULL) {
-                if (parent_node->left != NULL) {
-                    free(parent_node->left);
-                }
-                if (parent_node->right != NULL) {
-                    free(parent_node->right);
-                }
-                free(parent_node);
-            }
+            // whatever was built stays in the arena until the tree is freed
             return NULL;
         }
 
@@ -293,31 +408,80 @@ PARSER_NODE* parse_rule(struct rule **rule, size_t rule_size, LEX_SYMBOL *symbol
     return parent_node;
 }
 
-PARSER_NODE* parse_operator(LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index)
+/*
+ * Expressions are parsed by precedence climbing: every binary operator token
+ * has a binding power, and an operator only takes its right operand from
+ * operators that bind tighter. Each token is looked at once, there is no
+ * backtracking. All binary operators are left associative; 0 means the token
+ * ends the expression.
+ */
+static const uint8_t binding_power[LEX_SYM_NUMMER + 1] = {
+    [LEX_SYM_GELIJK_AAN] = 1,
+    [LEX_SYM_NIET_GELIJK_AAN] = 1,
+    [LEX_SYM_LAGER_DAN] = 2,
+    [LEX_SYM_LAGER_DAN_GELIJK_AAN] = 2,
+    [LEX_SYM_HOGER_DAN] = 2,
+    [LEX_SYM_HOGER_DAN_GELIJK_AAN] = 2,
+    [LEX_SYM_PLUS] = 3,
+    [LEX_SYM_MIN] = 3,
+    [LEX_SYM_KEER] = 4,
+    [LEX_SYM_DELEN] = 4,
+};
+
+// A literal, or a unary operator applied to one; unary operators bind tighter than any binary one
+static PARSER_NODE* parse_prefix(PARSER *p)
 {
-    PARSER_OPERATOR operator;
-    switch (symbols[*symbols_index].type) {
-        case LEX_SYM_PLUS:
-            operator = PARSER_OPERATOR_ADD;
+    LEX_SYMBOL symbol = *lex_peek(p->stream, 0);
+    PARSER_TYPE type;
+    switch (symbol.type) {
+        case LEX_SYM_NUMMER:
+        case LEX_SYM_TEKENREEKS:
+        case LEX_SYM_WAAR:
+        case LEX_SYM_ONWAAR:
+            lex_next(p->stream);
+            return expression_node(p, PARSER_TYPE_LITERAL, symbol, NULL, NULL);
+        case LEX_SYM_UITROEPTEKEN:
+            type = PARSER_TYPE_INVERT;
             break;
         case LEX_SYM_MIN:
-            operator = PARSER_OPERATOR_SUBTRACT;
-            break;
-        case LEX_SYM_KEER:
-            operator = PARSER_OPERATOR_MULTIPLY;
-            break;
-        case LEX_SYM_DELEN:
-            operator = PARSER_OPERATOR_DIVIDE;
+            type = PARSER_TYPE_NEGATE;
             break;
         default:
             return NULL;
     }
+    lex_next(p->stream);
 
-    PARSER_NODE *node = malloc(sizeof(PARSER_NODE));
-    node->type = PARSER_TYPE_OPERATOR;
-    node->operator = operator;
+    PARSER_NODE *operand = parse_prefix(p);
+    if (operand == NULL) {
+        return NULL;
+    }
+    return expression_node(p, type, symbol, NULL, operand);
+}
 
-    return node;
+// Parses operators binding tighter than min_power
+static PARSER_NODE* parse_binary(PARSER *p, uint8_t min_power)
+{
+    PARSER_NODE *left = parse_prefix(p);
+    while (left != NULL) {
+        LEX_SYMBOL symbol = *lex_peek(p->stream, 0);
+        uint8_t power = binding_power[symbol.type];
+        if (power <= min_power) {
+            break;
+        }
+        lex_next(p->stream);
+
+        PARSER_NODE *right = parse_binary(p, power);
+        if (right == NULL) {
+            return NULL;
+        }
+        left = expression_node(p, PARSER_TYPE_OPERATOR, symbol, left, right);
+    }
+    return left;
+}
+
+PARSER_NODE* parse_expression(PARSER *p)
+{
+    return parse_binary(p, 0);
 }
 
 struct ruleset {
@@ -325,240 +489,376 @@ struct ruleset {
     size_t size;
 };
 
+// Built once by parser_init and only read after that, so parses can share them across threads
+static struct ruleset assignment_rules;
+
 struct rule* ruleset_add(struct ruleset *ruleset, struct rule *rule)
 {
     ruleset->size += 1;
-    ruleset->rule = realloc(ruleset->rule, sizeof(struct rule*) * ruleset->size);
+    ruleset->rule = geheugen_realloc(NULL, GEHEUGEN_OVERIG, ruleset->rule, sizeof(struct rule*) * ruleset->size);
     ruleset->rule[ruleset->size-1] = rule;
     return rule;
 }
 
-PARSER_NODE* parse_primary(LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index)
+PARSER_NODE* parse_assignment(PARSER *p)
 {
-    static struct ruleset ruleset = { .rule = NULL, .size = 0 };
-    if (ruleset.rule == NULL) {
-        ruleset_add(&ruleset, rule_create_terminal(LEX_SYM_NUMMER, PRIORITY_PRIMARY, PARSER_TYPE_LITERAL));
-        ruleset_add(&ruleset, rule_create(RULE_TYPE_OR));
-        ruleset_add(&ruleset, rule_create_terminal(LEX_SYM_TEKENREEKS, PRIORITY_PRIMARY, PARSER_TYPE_LITERAL));
-        ruleset_add(&ruleset, rule_create(RULE_TYPE_OR));
-        ruleset_add(&ruleset, rule_create_terminal(LEX_SYM_WAAR, PRIORITY_PRIMARY, PARSER_TYPE_LITERAL));
-        ruleset_add(&ruleset, rule_create(RULE_TYPE_OR));
-        ruleset_add(&ruleset, rule_create_terminal(LEX_SYM_ONWAAR, PRIORITY_PRIMARY, PARSER_TYPE_LITERAL));
+    PARSER_NODE *node = parse_rule(assignment_rules.rule, assignment_rules.size, p);
+
+    // the statement ends at its ';', the last one of a file may leave it out; empty statements are skipped
+    while (node != NULL && lex_peek(p->stream, 0)->type == LEX_SYM_PUNTKOMMA) {
+        lex_next(p->stream);
     }
+    return node;
+}
 
-    return parse_rule(ruleset.rule, ruleset.size, symbols, symbols_size, symbols_index);
+static void build_assignment(struct ruleset *ruleset)
+{
+    ruleset_add(ruleset, rule_create_terminal(LEX_SYM_NAAM, PRIORITY_SECONDARY, PARSER_TYPE_IDENTIFIER));
+    ruleset_add(ruleset, rule_create_terminal(LEX_SYM_IS, PRIORITY_PRIMARY, PARSER_TYPE_ASSIGNMENT));
+    ruleset_add(ruleset, rule_create_non_terminal(parse_expression, PRIORITY_SECONDARY));
+    // ruleset_add(ruleset, rule_create_terminal(LEX_SYM_PUNTKOMMA, PRIORITY_NONE, PARSER_TYPE_NONE));
 }
 
-PARSER_NODE* parse_unary(LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index)
+static void parse(PARSER *p, PARSER_NODE_BODY *body);
+
+PARSER_NODE* parse_if(PARSER *p)
 {
-    static struct ruleset ruleset = { .rule = NULL, .size = 0 };
-    if (ruleset.rule == NULL) {
-        struct rule *group = ruleset_add(&ruleset, rule_create(RULE_TYPE_GROUP));
-        rule_add_to_group(group, rule_create_terminal(LEX_SYM_UITROEPTEKEN, PRIORITY_PRIMARY, PARSER_TYPE_INVERT));
-        rule_add_to_group(group, rule_create(RULE_TYPE_OR));
-        rule_add_to_group(group, rule_create_terminal(LEX_SYM_MIN, PRIORITY_PRIMARY, PARSER_TYPE_NEGATE));
+    if (lex_peek(p->stream, 0)->type == LEX_SYM_EINDE) return NULL;
 
-        ruleset_add(&ruleset, rule_create_non_terminal(parse_unary, PRIORITY_SECONDARY));
-        ruleset_add(&ruleset, rule_create(RULE_TYPE_OR));
-        ruleset_add(&ruleset, rule_create_non_terminal(parse_primary, PRIORITY_SECONDARY));
-    }
+    if (lex_peek(p->stream, 0)->type != LEX_SYM_ALS) return NULL;
+    lex_next(p->stream);
 
-    return parse_rule(ruleset.rule, ruleset.size, symbols, symbols_size, symbols_index);
-}
+    PARSER_NODE *expression = parse_expression(p);
+    if (expression == NULL) return NULL;
 
-PARSER_NODE* parse_factor(LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index)
-{
-    static struct ruleset ruleset = { .rule = NULL, .size = 0 };
-    if (ruleset.rule == NULL) {
+    if (lex_peek(p->stream, 0)->type == LEX_SYM_EINDE) return NULL;
 
-        // Add to ruleset
-        ruleset_add(&ruleset, rule_create_non_terminal(parse_unary, PRIORITY_SECONDARY));
+    if (lex_peek(p->stream, 0)->type != LEX_SYM_ACCOLADE_OPEN) return NULL;
+    lex_next(p->stream);
 
-        struct rule *group = ruleset_add(&ruleset, rule_create(RULE_TYPE_GROUP));
+    PARSER_NODE_BODY true_body;
+    parse(p, &true_body);
 
-        struct rule *div_or_mul = rule_add_to_group(group, rule_create(RULE_TYPE_GROUP));
-        rule_add_to_group(div_or_mul, rule_create_terminal(LEX_SYM_DELEN, PRIORITY_PRIMARY, PARSER_TYPE_OPERATOR));
-        rule_add_to_group(div_or_mul, rule_create(RULE_TYPE_OR));
-        rule_add_to_group(div_or_mul, rule_create_terminal(LEX_SYM_KEER, PRIORITY_PRIMARY, PARSER_TYPE_OPERATOR));
+    if (lex_peek(p->stream, 0)->type != LEX_SYM_ACCOLADE_SLUIT) return NULL;
+    lex_next(p->stream);
 
-        rule_add_to_group(group, rule_create_non_terminal(parse_unary, PRIORITY_SECONDARY));
-        rule_set_repeat(group, REPEAT_ZERO_OR_MORE);
+    // like an assignment, the block may be followed by empty statements
+    while (lex_peek(p->stream, 0)->type == LEX_SYM_PUNTKOMMA) {
+        lex_next(p->stream);
     }
 
-    return parse_rule(ruleset.rule, ruleset.size, symbols, symbols_size, symbols_index);
-}
-
-PARSER_NODE* parse_term(LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index)
-{
-    static struct ruleset ruleset = { .rule = NULL, .size = 0 };
-    if (ruleset.rule == NULL) {
-        // Add to ruleset
-        ruleset_add(&ruleset, rule_create_non_terminal(parse_factor, PRIORITY_SECONDARY));
+    PARSER_NODE *node = node_create(p);
+    node->type = PARSER_TYPE_CONDITIONAL;
+    node->expression = expression;
+    node->left = NULL;
+    node->right = NULL;
 
-        struct rule *group = ruleset_add(&ruleset, rule_create(RULE_TYPE_GROUP));
+    PARSER_NODE *true_node = node_create(p);
+    true_node->type = PARSER_TYPE_BODY;
+    true_node->left = NULL;
+    true_node->right = NULL;
+    true_node->body = true_body;
+    node->right = true_node;
 
-        struct rule *add_or_sub = rule_add_to_group(group, rule_create(RULE_TYPE_GROUP));
-        rule_add_to_group(add_or_sub, rule_create_terminal(LEX_SYM_MIN, PRIORITY_PRIMARY, PARSER_TYPE_OPERATOR));
-        rule_add_to_group(add_or_sub, rule_create(RULE_TYPE_OR));
-        rule_add_to_group(add_or_sub, rule_create_terminal(LEX_SYM_PLUS, PRIORITY_PRIMARY, PARSER_TYPE_OPERATOR));
+    return node;
+}
 
-        rule_add_to_group(group, rule_create_non_terminal(parse_factor, PRIORITY_SECONDARY));
-        rule_set_repeat(group, REPEAT_ZERO_OR_MORE);
+static void pending_add(PARSER *p, PARSER_NODE *node)
+{
+    if (p->pending_size == p->pending_allocated) {
+        p->pending_allocated = p->pending_allocated == 0 ? 64 : p->pending_allocated * 2;
+        p->pending = geheugen_realloc(p->omgeving->geheugen, GEHEUGEN_BOOM, p->pending, sizeof(PARSER_NODE*) * p->pending_allocated);
     }
-
-    return parse_rule(ruleset.rule, ruleset.size, symbols, symbols_size, symbols_index);
+    p->pending[p->pending_size++] = node;
 }
 
-PARSER_NODE* parse_comparison(LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index)
+static void parse(PARSER *p, PARSER_NODE_BODY *body)
 {
-    static struct ruleset ruleset = { .rule = NULL, .size = 0 };
-    if (ruleset.rule == NULL) {
-        // Add to ruleset
-        ruleset_add(&ruleset, rule_create_non_terminal(parse_term, PRIORITY_SECONDARY));
+    size_t first = p->pending_size;
+    p->depth++;
+
+    PARSER_NODE* (*rule_funcs[])(PARSER*) = {
+        parse_if,
+        parse_assignment,
+    };
+    size_t rule_funcs_size = sizeof(rule_funcs) / sizeof(rule_funcs[0]);
+
+    while (lex_peek(p->stream, 0)->type != LEX_SYM_EINDE) {
+        // if (lex_peek(stream, 0)->type != LEX_SYM_PUNTKOMMA && body->expressions_size > 0) {
+        //     printf("%d\n", lex_peek(stream, 0)->type);
+        //     printf("error here\n");
+        // }
 
-        struct rule *group = ruleset_add(&ruleset, rule_create(RULE_TYPE_GROUP));
+        // if (body->expressions_size > 0) {
+        //     symbols_index++;
+        // }
 
-        struct rule *subgroup = rule_add_to_group(group, rule_create(RULE_TYPE_GROUP));
-        rule_add_to_group(subgroup, rule_create_terminal(LEX_SYM_HOGER_DAN, PRIORITY_PRIMARY, PARSER_TYPE_OPERATOR));
-        rule_add_to_group(subgroup, rule_create(RULE_TYPE_OR));
-        rule_add_to_group(subgroup, rule_create_terminal(LEX_SYM_HOGER_DAN_GELIJK_AAN, PRIORITY_PRIMARY, PARSER_TYPE_OPERATOR));
-        rule_add_to_group(subgroup, rule_create(RULE_TYPE_OR));
-        rule_add_to_group(subgroup, rule_create_terminal(LEX_SYM_LAGER_DAN, PRIORITY_PRIMARY, PARSER_TYPE_OPERATOR));
-        rule_add_to_group(subgroup, rule_create(RULE_TYPE_OR));
-        rule_add_to_group(subgroup, rule_create_terminal(LEX_SYM_LAGER_DAN_GELIJK_AAN, PRIORITY_PRIMARY, PARSER_TYPE_OPERATOR));
+        PARSER_NODE *current_node = NULL;
+        for (size_t i = 0; i < rule_funcs_size; i++) {
+            current_node = (rule_funcs[i])(p);
+            if (current_node != NULL) {
+                // only the outermost body records where its statements end
+                if (p->depth == 1) {
+                    p->parsed = p->stream->index;
+                    if (p->ends != NULL) {
+                        p->ends[p->pending_size - first] = p->parsed;
+                    }
+                }
+                pending_add(p, current_node);
+                break;
+            }
+        }
+        if (current_node == NULL) {
+            // error here
+            break;
+        }
+    }
 
-        rule_add_to_group(group, rule_create_non_terminal(parse_term, PRIORITY_SECONDARY));
-        rule_set_repeat(group, REPEAT_ZERO_OR_MORE);
+    // the body's statements are known now, so they get exactly the space they need
+    body->expressions_size = p->pending_size - first;
+    body->expressions = arena_alloc(p->arena, sizeof(PARSER_NODE*) * body->expressions_size);
+    if (body->expressions_size > 0) {
+        memcpy(body->expressions, p->pending + first, sizeof(PARSER_NODE*) * body->expressions_size);
     }
+    p->pending_size = first;
+    p->depth--;
+}
 
-    return parse_rule(ruleset.rule, ruleset.size, symbols, symbols_size, symbols_index);
+static pthread_once_t grammar_built = PTHREAD_ONCE_INIT;
+
+static void build_grammar(void)
+{
+    build_assignment(&assignment_rules);
 }
 
-PARSER_NODE* parse_equality(LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index)
+void parser_init(void)
 {
-    static struct ruleset ruleset = { .rule = NULL, .size = 0 };
-    if (ruleset.rule == NULL) {
-        // Add to ruleset
-        ruleset_add(&ruleset, rule_create_non_terminal(parse_comparison, PRIORITY_SECONDARY));
+    pthread_once(&grammar_built, build_grammar);
+}
 
-        struct rule *group = ruleset_add(&ruleset, rule_create(RULE_TYPE_GROUP));
+// parsed, if not NULL, is set to the number of tokens taken by the statements in the body
+static PARSER_NODE_BODY* parse_tree(OMGEVING *omgeving, LEX_STROOM *stream, size_t *ends, size_t *parsed)
+{
+    parser_init();
 
-        struct rule *subgroup = rule_add_to_group(group, rule_create(RULE_TYPE_GROUP));
-        rule_add_to_group(subgroup, rule_create_terminal(LEX_SYM_NIET_GELIJK_AAN, PRIORITY_PRIMARY, PARSER_TYPE_OPERATOR));
-        rule_add_to_group(subgroup, rule_create(RULE_TYPE_OR));
-        rule_add_to_group(subgroup, rule_create_terminal(LEX_SYM_GELIJK_AAN, PRIORITY_PRIMARY, PARSER_TYPE_OPERATOR));
+    struct parser_tree *tree = geheugen_alloc(omgeving->geheugen, GEHEUGEN_BOOM, sizeof(struct parser_tree));
+    arena_init(&tree->arena, omgeving->geheugen, GEHEUGEN_BOOM);
 
-        rule_add_to_group(group, rule_create_non_terminal(parse_comparison, PRIORITY_SECONDARY));
-        rule_set_repeat(group, REPEAT_ZERO_OR_MORE);
+    PARSER p = {
+        .stream = stream,
+        .omgeving = omgeving,
+        .arena = &tree->arena,
+        .ends = ends,
+    };
+    parse(&p, &tree->body);
+    geheugen_vrij(p.pending);
+    geheugen_vrij(p.shared);
+    if (parsed != NULL) {
+        *parsed = p.parsed;
     }
-
-    return parse_rule(ruleset.rule, ruleset.size, symbols, symbols_size, symbols_index);
+    return &tree->body;
 }
 
-PARSER_NODE* parse_expression(LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index)
+PARSER_NODE_BODY* parser(OMGEVING *omgeving, LEX_SYMBOL *symbols, size_t symbols_size)
 {
-    return parse_equality(symbols, symbols_size, symbols_index);
+    if (symbols_size >= PARSER_PARALLEL_THRESHOLD) {
+        return parser_parallel(omgeving, symbols, symbols_size, 0);
+    }
+    LEX_STROOM stream;
+    lex_open_symbolen(&stream, symbols, symbols_size);
+    return parse_tree(omgeving, &stream, NULL, NULL);
 }
 
-PARSER_NODE* parse_assignment(LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index)
+PARSER_NODE_BODY* parser_stream(OMGEVING *omgeving, LEX_STROOM *stream)
 {
-    static struct ruleset ruleset = { .rule = NULL, .size = 0 };
-    if (ruleset.rule == NULL) {
-        ruleset_add(&ruleset, rule_create_terminal(LEX_SYM_NAAM, PRIORITY_SECONDARY, PARSER_TYPE_IDENTIFIER));
-        ruleset_add(&ruleset, rule_create_terminal(LEX_SYM_IS, PRIORITY_PRIMARY, PARSER_TYPE_ASSIGNMENT));
-        ruleset_add(&ruleset, rule_create_non_terminal(parse_expression, PRIORITY_SECONDARY));
-        // ruleset_add(&ruleset, rule_create_terminal(LEX_SYM_PUNTKOMMA, PRIORITY_NONE, PARSER_TYPE_NONE));
-    }
-
-    return parse_rule(ruleset.rule, ruleset.size, symbols, symbols_size, symbols_index);
+    return parse_tree(omgeving, stream, NULL, NULL);
 }
 
-PARSER_NODE_BODY* parse(LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index);
-
-PARSER_NODE* parse_if(LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index)
+PARSER_NODE_BODY* parser_statements(OMGEVING *omgeving, LEX_SYMBOL *symbols, size_t symbols_size, size_t *ends)
 {
-    if (*symbols_index >= symbols_size) return NULL;
-
-    if (symbols[*symbols_index].type != LEX_SYM_ALS) return NULL;
-    *symbols_index += 1;
+    LEX_STROOM stream;
+    lex_open_symbolen(&stream, symbols, symbols_size);
+    return parse_tree(omgeving, &stream, ends, NULL);
+}
 
-    skip_unimportant_symbols(symbols, symbols_size, symbols_index);
+// A run of top-level statements, parsed on a thread of its own
+typedef struct {
+    // a copy, so the counters are not shared between threads
+    OMGEVING omgeving;
+    LEX_SYMBOL *symbols;
+    size_t begin;
+    size_t end;
 
-    PARSER_NODE *expression = parse_expression(symbols, symbols_size, symbols_index);
-    if (expression == NULL) return NULL;
+    PARSER_NODE_BODY *body;
+    size_t parsed;
 
-    skip_unimportant_symbols(symbols, symbols_size, symbols_index);
+    pthread_t id;
+    bool thread;
+} parser_chunk;
 
-    if (*symbols_index >= symbols_size) return NULL;
+static void* parse_chunk(void *arg)
+{
+    parser_chunk *chunk = arg;
+    LEX_STROOM stream;
+    lex_open_symbolen(&stream, chunk->symbols + chunk->begin, chunk->end - chunk->begin);
+    chunk->body = parse_tree(&chunk->omgeving, &stream, NULL, &chunk->parsed);
+    return NULL;
+}
 
-    if (symbols[*symbols_index].type != LEX_SYM_ACCOLADE_OPEN) return NULL;
-    *symbols_index += 1;
+/*
+ * A top-level statement can start at a name that follows a semicolon
+ * outside of any braces. Neither a name nor the end of the tokens continues
+ * an expression, so the statements before such a point parse the same with
+ * or without the tokens after it. Only the braces are counted; the chunks
+ * are checked when they are put together.
+ */
+static size_t find_chunks(LEX_SYMBOL *symbols, size_t symbols_size, size_t *begins, size_t threads)
+{
+    size_t chunks = 1;
+    begins[0] = 0;
+    size_t depth = 0;
+    for (size_t i = 0; i < symbols_size && chunks < threads; i++) {
+        if (depth == 0 && i > 0 && i >= symbols_size / threads * chunks
+            && symbols[i - 1].type == LEX_SYM_PUNTKOMMA && symbols[i].type == LEX_SYM_NAAM) {
+            begins[chunks++] = i;
+        }
+        if (symbols[i].type == LEX_SYM_ACCOLADE_OPEN) {
+            depth++;
+        } else if (symbols[i].type == LEX_SYM_ACCOLADE_SLUIT && depth > 0) {
+            depth--;
+        }
+    }
+    return chunks;
+}
 
-    PARSER_NODE_BODY *true_body = parse(symbols, symbols_size, symbols_index);
+PARSER_NODE_BODY* parser_parallel(OMGEVING *omgeving, LEX_SYMBOL *symbols, size_t symbols_size, size_t threads)
+{
+    if (threads == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (size_t)online : 1;
+    }
+    parser_init();
+
+    size_t *begins = geheugen_alloc(omgeving->geheugen, GEHEUGEN_BOOM, sizeof(size_t) * threads);
+    size_t chunks_size = find_chunks(symbols, symbols_size, begins, threads);
+    parser_chunk *chunks = geheugen_nul(omgeving->geheugen, GEHEUGEN_BOOM, chunks_size, sizeof(parser_chunk));
+    for (size_t i = 0; i < chunks_size; i++) {
+        chunks[i].omgeving = *omgeving;
+        chunks[i].omgeving.gedeeld = 0;
+        chunks[i].symbols = symbols;
+        chunks[i].begin = begins[i];
+        chunks[i].end = i + 1 < chunks_size ? begins[i + 1] : symbols_size;
+    }
+    geheugen_vrij(begins);
+
+    // diagnostics of all chunks go to the same omgeving->uit
+    for (size_t i = 1; i < chunks_size; i++) {
+        chunks[i].thread = pthread_create(&chunks[i].id, NULL, parse_chunk, &chunks[i]) == 0;
+        if (!chunks[i].thread) {
+            // no thread to be had: parse it here
+            parse_chunk(&chunks[i]);
+        }
+    }
+    parse_chunk(&chunks[0]);
+    for (size_t i = 1; i < chunks_size; i++) {
+        if (chunks[i].thread) {
+            pthread_join(chunks[i].id, NULL);
+        }
+    }
 
-    skip_unimportant_symbols(symbols, symbols_size, symbols_index);
-    if (symbols[*symbols_index].type != LEX_SYM_ACCOLADE_SLUIT) return NULL;
+    /*
+     * A chunk counts as long as every chunk before it parsed to its end. At
+     * the first one that did not, the statement it stopped at may run on
+     * into the next chunk, so everything from there is parsed again in one
+     * go and the chunks after it are thrown away.
+     */
+    size_t used = 0;
+    while (used < chunks_size && chunks[used].parsed == chunks[used].end - chunks[used].begin) {
+        used++;
+    }
+    PARSER_NODE_BODY *rest = NULL;
+    if (used < chunks_size) {
+        LEX_STROOM stream;
+        size_t begin = chunks[used].begin + chunks[used].parsed;
+        lex_open_symbolen(&stream, symbols + begin, symbols_size - begin);
+        rest = parse_tree(omgeving, &stream, NULL, NULL);
+        used++;
+    }
 
-    PARSER_NODE *node = malloc(sizeof(PARSER_NODE));
-    node->type = PARSER_TYPE_CONDITIONAL;
-    node->expression = expression;
-    node->left = NULL;
-    node->right = NULL;
+    size_t statements = rest != NULL ? rest->expressions_size : 0;
+    for (size_t i = 0; i < used; i++) {
+        statements += chunks[i].body->expressions_size;
+        omgeving->gedeeld += chunks[i].omgeving.gedeeld;
+    }
 
-    PARSER_NODE *true_node = malloc(sizeof(PARSER_NODE));
-    true_node->type = PARSER_TYPE_BODY;
-    true_node->right = NULL;
-    true_node->body = *true_body;
-    node->right = true_node;
+    // everything moves into the tree of the first chunk, so parser_free is the same as for parser
+    struct parser_tree *tree = (struct parser_tree*)chunks[0].body;
+    PARSER_NODE **expressions = arena_alloc(&tree->arena, sizeof(PARSER_NODE*) * statements);
+    size_t size = 0;
+    for (size_t i = 0; i <= used; i++) {
+        PARSER_NODE_BODY *body = i < used ? chunks[i].body : rest;
+        if (body == NULL) {
+            continue;
+        }
+        if (body->expressions_size > 0) {
+            memcpy(expressions + size, body->expressions, sizeof(PARSER_NODE*) * body->expressions_size);
+            size += body->expressions_size;
+        }
+        if (i > 0) {
+            struct parser_tree *other = (struct parser_tree*)body;
+            arena_neem_over(&tree->arena, &other->arena);
+            geheugen_vrij(other);
+        }
+    }
+    tree->body.expressions = expressions;
+    tree->body.expressions_size = statements;
 
-    return node;
+    for (size_t i = used; i < chunks_size; i++) {
+        parser_free(chunks[i].body);
+    }
+    geheugen_vrij(chunks);
+    return &tree->body;
 }
 
-PARSER_NODE_BODY* parse(LEX_SYMBOL *symbols, size_t symbols_size, size_t *symbols_index)
-{
-    PARSER_NODE_BODY *body = malloc(sizeof(PARSER_NODE_BODY));
-    body->expressions = NULL;
-    body->expressions_size = 0;
-
-    PARSER_NODE* (*rule_funcs[])(LEX_SYMBOL*, size_t, size_t*) = {
-        parse_if,
-        parse_assignment,
-    };
-    size_t rule_funcs_size = sizeof(rule_funcs) / sizeof(rule_funcs[0]);
+static size_t count_body(const PARSER_NODE_BODY *body);
 
-    while (*symbols_index < symbols_size) {
-        skip_unimportant_symbols(symbols, symbols_size, symbols_index);
-        // if (symbols[*symbols_index].type != LEX_SYM_PUNTKOMMA && body->expressions_size > 0) {
-        //     printf("%d\n", symbols[*symbols_index].type);
-        //     printf("error here\n");
-        // }
+size_t parser_subtree_count(const PARSER_NODE *node)
+{
+    if (node == NULL) {
+        return 0;
+    }
 
-        // if (body->expressions_size > 0) {
-        //     symbols_index++;
-        // }
+    size_t count = 1 + parser_subtree_count(node->left) + parser_subtree_count(node->right);
+    if (node->type == PARSER_TYPE_BODY) {
+        count += count_body(&node->body);
+    } else if (node->type == PARSER_TYPE_CONDITIONAL) {
+        count += parser_subtree_count(node->expression);
+    }
+    return count;
+}
 
-        PARSER_NODE *current_node = NULL;
-        for (size_t i = 0; i < rule_funcs_size; i++) {
-            current_node = (rule_funcs[i])(symbols, symbols_size, symbols_index);
-            if (current_node != NULL) {
-                body->expressions = realloc(body->expressions, sizeof(PARSER_NODE*) * body->expressions_size + 1);
-                body->expressions[body->expressions_size++] = current_node;
-                break;
-            }
-        }
-        if (current_node == NULL) {
-            // error here
-            break;
-        }
+static size_t count_body(const PARSER_NODE_BODY *body)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < body->expressions_size; i++) {
+        count += parser_subtree_count(body->expressions[i]);
     }
+    return count;
+}
 
-    return body;
+size_t parser_node_count(const PARSER_NODE_BODY *body)
+{
+    return body != NULL ? count_body(body) : 0;
 }
 
-PARSER_NODE_BODY* parser(LEX_SYMBOL *symbols, size_t symbols_size)
+void parser_free(PARSER_NODE_BODY *body)
 {
-    size_t symbols_index = 0;
-    return parse(symbols, symbols_size, &symbols_index);
+    if (body != NULL) {
+        // the root body is the first member of its tree
+        struct parser_tree *tree = (struct parser_tree*)body;
+        arena_vrij(&tree->arena);
+        geheugen_vrij(tree);
+    }
 }
 
 static char* get_parser_type(PARSER_TYPE type)
@@ -595,68 +895,70 @@ static char* get_parser_type(PARSER_TYPE type)
     }
 }
 
-static void recursive_node_print(PARSER_NODE *node, int level)
+static void recursive_node_print(FILE *out, PARSER_NODE *node, int level)
 {
-    printf("%s ", get_parser_type(node->type));
+    fprintf(out, "%s ", get_parser_type(node->type));
     if (node->type == PARSER_TYPE_LITERAL) {
         if (node->literal == PARSER_LITERAL_NUMBER) {
-            printf("%i", node->number);
+            fprintf(out, "%i", node->number);
         } else if (node->literal == PARSER_LITERAL_BOOLEAN) {
-            printf("%s", node->boolean ? "waar" : "onwaar");
+            fprintf(out, "%s", node->boolean ? "waar" : "onwaar");
         } else if (node->literal == PARSER_LITERAL_STRING) {
-            printf("\"%s\"", node->string);
+            INTERN_TEKST string = intern_tekst(node->string);
+            fprintf(out, "\"%.*s\"", (int)string.lengte, string.tekst);
         }
     } else if (node->type == PARSER_TYPE_IDENTIFIER) {
-        printf("%s", node->identifier);
+        INTERN_TEKST identifier = intern_tekst(node->identifier);
+        fprintf(out, "%.*s", (int)identifier.lengte, identifier.tekst);
     } else if (node->type == PARSER_TYPE_OPERATOR) {
         switch (node->operator) {
-            case PARSER_OPERATOR_ADD: printf("+"); break;
-            case PARSER_OPERATOR_SUBTRACT: printf("-"); break;
-            case PARSER_OPERATOR_MULTIPLY: printf("*"); break;
-            case PARSER_OPERATOR_DIVIDE: printf("/"); break;
-            case PARSER_OPERATOR_EQUAL_TO: printf("=="); break;
-            case PARSER_OPERATOR_NOT_EQUAL_TO: printf("!="); break;
-            case PARSER_OPERATOR_LOWER_THAN: printf("<"); break;
-            case PARSER_OPERATOR_LOWER_THAN_EQUAL_TO: printf("<="); break;
-            case PARSER_OPERATOR_HIGHER_THAN: printf(">"); break;
-            case PARSER_OPERATOR_HIGHER_THAN_EQUAL_TO: printf(">="); break;
+            case PARSER_OPERATOR_ADD: fprintf(out, "+"); break;
+            case PARSER_OPERATOR_SUBTRACT: fprintf(out, "-"); break;
+            case PARSER_OPERATOR_MULTIPLY: fprintf(out, "*"); break;
+            case PARSER_OPERATOR_DIVIDE: fprintf(out, "/"); break;
+            case PARSER_OPERATOR_EQUAL_TO: fprintf(out, "=="); break;
+            case PARSER_OPERATOR_NOT_EQUAL_TO: fprintf(out, "!="); break;
+            case PARSER_OPERATOR_LOWER_THAN: fprintf(out, "<"); break;
+            case PARSER_OPERATOR_LOWER_THAN_EQUAL_TO: fprintf(out, "<="); break;
+            case PARSER_OPERATOR_HIGHER_THAN: fprintf(out, ">"); break;
+            case PARSER_OPERATOR_HIGHER_THAN_EQUAL_TO: fprintf(out, ">="); break;
         }
     } else if (node->type == PARSER_TYPE_CONDITIONAL) {
-        printf("\n%*sCondition: ", level*4, "");
-        recursive_node_print(node->expression, level+1);
+        fprintf(out, "\n%*sCondition: ", level*4, "");
+        recursive_node_print(out, node->expression, level+1);
     } else if (node->type == PARSER_TYPE_BODY) {
-        printf("\n");
+        fprintf(out, "\n");
         for (size_t i = 0; i < node->body.expressions_size; i++) {
-            printf("%*s", level*4, "");
+            fprintf(out, "%*s", level*4, "");
             // printf("%p\n", (void*)body->expressions[i]);
             if (node->body.expressions[i] != NULL) {
-                recursive_node_print(node->body.expressions[i], level+1);
+                recursive_node_print(out, node->body.expressions[i], level+1);
             } else {
-                printf("NULL\n");
+                fprintf(out, "NULL\n");
             }
         }
     }
-    printf("\n");
+    fprintf(out, "\n");
 
     if (node->left != NULL) {
-        printf("%*sLeft Node: ", level*4, "");
-        recursive_node_print(node->left, level+1);
+        fprintf(out, "%*sLeft Node: ", level*4, "");
+        recursive_node_print(out, node->left, level+1);
     }
 
     if (node->right != NULL) {
-        printf("%*sRight Node: ", level*4, "");
-        recursive_node_print(node->right, level+1);
+        fprintf(out, "%*sRight Node: ", level*4, "");
+        recursive_node_print(out, node->right, level+1);
     }
 }
 
-void parser_debug_print(PARSER_NODE_BODY *body)
+void parser_debug_print(FILE *out, PARSER_NODE_BODY *body)
 {
     for (size_t i = 0; i < body->expressions_size; i++) {
         // printf("%p\n", (void*)body->expressions[i]);
         if (body->expressions[i] != NULL) {
-            recursive_node_print(body->expressions[i], 1);
+            recursive_node_print(out, body->expressions[i], 1);
         } else {
-            printf("NULL\n");
+            fprintf(out, "NULL\n");
         }
     }
 }
@@ -4,6 +4,7 @@
 #include <stddef.h>
 #include <stdint.h>
 #include "lexer.h"
+#include "omgeving.h"
 
 typedef enum {
     PARSER_TYPE_NONE,
@@ -67,8 +68,9 @@ struct parser_node {
 
     union {
         PARSER_NODE_BODY body;
-        char *identifier;
-        char *string;
+        // atoms from the intern table, equal text means equal atom
+        INTERN_ATOOM identifier;
+        INTERN_ATOOM string;
         uint32_t number;
         bool boolean;
     };
@@ -79,7 +81,44 @@ struct parser_node {
     struct parser_node *right;
 };
 
-PARSER_NODE_BODY* parser(LEX_SYMBOL *symbols, size_t symbols_size);
-void parser_debug_print(PARSER_NODE_BODY *body);
+// Builds the grammar tables, once per process; parser and parser_stream call it themselves
+void parser_init(void);
+// From this many symbols on, parser splits the program over all processors
+#define PARSER_PARALLEL_THRESHOLD (1024 * 1024)
+
+/*
+ * Diagnostics go to omgeving->uit; any number of threads may parse at once,
+ * each with its own omgeving.
+ *
+ * With omgeving->delen expression nodes are hash-consed: literals, names and
+ * operators over equal operands are built once per parse, so within one
+ * tree two expressions are equal exactly when they are the same node.
+ * parser_parallel shares within each of its runs. The counts of
+ * parser_node_count stay those of the unshared tree; a pass that rewrites a
+ * node in place, like optimize, rewrites it everywhere it occurs.
+ */
+PARSER_NODE_BODY* parser(OMGEVING *omgeving, LEX_SYMBOL *symbols, size_t symbols_size);
+/*
+ * The same tree as parser, with the top-level statements split into threads
+ * runs that are parsed at once (0: one per processor) and put back together
+ * in source order. Diagnostics of all threads go to omgeving->uit.
+ */
+PARSER_NODE_BODY* parser_parallel(OMGEVING *omgeving, LEX_SYMBOL *symbols, size_t symbols_size, size_t threads);
+// Parses tokens as the lexer produces them, only LEX_VOORUIT of them are kept in memory
+PARSER_NODE_BODY* parser_stream(OMGEVING *omgeving, LEX_STROOM *stream);
+/*
+ * Like parser, and sets ends[i] to the number of symbols up to the end of
+ * top-level statement i. ends needs room for symbols_size entries, as there
+ * are never more statements than symbols. If a statement fails to parse,
+ * the last entry is less than symbols_size.
+ */
+PARSER_NODE_BODY* parser_statements(OMGEVING *omgeving, LEX_SYMBOL *symbols, size_t symbols_size, size_t *ends);
+// Number of nodes in the tree, for statistics
+size_t parser_node_count(const PARSER_NODE_BODY *body);
+// The same for one node and everything below it; 0 for NULL
+size_t parser_subtree_count(const PARSER_NODE *node);
+// Frees the whole tree returned by parser or parser_stream; its nodes all live in one arena, so this is one call
+void parser_free(PARSER_NODE_BODY *body);
+void parser_debug_print(FILE *out, PARSER_NODE_BODY *body);
 
 #endif
@@ -0,0 +1,569 @@
+#include "scanner.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SCAN_X86
+#include <immintrin.h>
+#endif
+
+#define IS_LETTER(c) (((c) >= 'a' && (c) <= 'z') || ((c) >= 'A' && (c) <= 'Z'))
+#define IS_CIJFER(c) ((c) >= '0' && (c) <= '9')
+#define IS_HEX(c) (IS_CIJFER(c) || ((c) >= 'a' && (c) <= 'f') || ((c) >= 'A' && (c) <= 'F'))
+
+#define K(c) ( \
+    (IS_LETTER(c) ? SCAN_KLASSE_LETTER : 0) | \
+    (IS_CIJFER(c) ? SCAN_KLASSE_CIJFER : 0) | \
+    (IS_HEX(c) ? SCAN_KLASSE_HEX : 0) | \
+    (IS_LETTER(c) || IS_CIJFER(c) || (c) == '-' || (c) == '_' ? SCAN_KLASSE_NAAM : 0))
+#define K4(c) K(c), K((c)+1), K((c)+2), K((c)+3)
+#define K16(c) K4(c), K4((c)+4), K4((c)+8), K4((c)+12)
+#define K64(c) K16(c), K16((c)+16), K16((c)+32), K16((c)+48)
+
+const uint8_t scan_klassen[256] = { K64(0), K64(64), K64(128), K64(192) };
+
+typedef enum {
+    SCAN_SOORT_SPATIES,
+    SCAN_SOORT_NAAM,
+    SCAN_SOORT_NUMMER,
+    SCAN_SOORT_TEKENREEKS,
+} SCAN_SOORT;
+
+static inline bool scalair_hoort_erbij(unsigned char c, SCAN_SOORT soort)
+{
+    switch (soort) {
+        case SCAN_SOORT_SPATIES:
+            return c == ' ';
+        case SCAN_SOORT_NAAM:
+            return scan_klassen[c] & SCAN_KLASSE_NAAM;
+        case SCAN_SOORT_NUMMER:
+            return scan_klassen[c] & SCAN_KLASSE_HEX;
+        case SCAN_SOORT_TEKENREEKS:
+            return c != '"' && c != '\\';
+    }
+    return false;
+}
+
+static inline size_t scalair_scan(const char *buf, size_t bufsize, size_t offset, SCAN_SOORT soort)
+{
+    size_t i = offset;
+    while (i < bufsize && scalair_hoort_erbij((unsigned char)buf[i], soort)) {
+        i++;
+    }
+    return i - offset;
+}
+
+static size_t scalair_spaties(const char *buf, size_t bufsize, size_t offset)
+{
+    return scalair_scan(buf, bufsize, offset, SCAN_SOORT_SPATIES);
+}
+
+static size_t scalair_naam(const char *buf, size_t bufsize, size_t offset)
+{
+    return scalair_scan(buf, bufsize, offset, SCAN_SOORT_NAAM);
+}
+
+static size_t scalair_nummer(const char *buf, size_t bufsize, size_t offset)
+{
+    return scalair_scan(buf, bufsize, offset, SCAN_SOORT_NUMMER);
+}
+
+static size_t scalair_tekenreeks(const char *buf, size_t bufsize, size_t offset)
+{
+    return scalair_scan(buf, bufsize, offset, SCAN_SOORT_TEKENREEKS);
+}
+
+size_t scan_utf8_teken(const char *buf, size_t bufsize, size_t offset, uint32_t *codepunt)
+{
+    const unsigned char *p = (const unsigned char*)buf + offset;
+    size_t rest = bufsize - offset;
+    size_t lengte;
+    uint32_t teken, minimum;
+
+    if (rest == 0) {
+        return 0;
+    }
+    if (p[0] < 0x80) {
+        *codepunt = p[0];
+        return 1;
+    }
+
+    if ((p[0] & 0xE0) == 0xC0) {
+        lengte = 2;
+        teken = p[0] & 0x1F;
+        minimum = 0x80;
+    } else if ((p[0] & 0xF0) == 0xE0) {
+        lengte = 3;
+        teken = p[0] & 0x0F;
+        minimum = 0x800;
+    } else if ((p[0] & 0xF8) == 0xF0) {
+        lengte = 4;
+        teken = p[0] & 0x07;
+        minimum = 0x10000;
+    } else {
+        return 0;
+    }
+
+    if (rest < lengte) {
+        return 0;
+    }
+    for (size_t i = 1; i < lengte; i++) {
+        if ((p[i] & 0xC0) != 0x80) {
+            return 0;
+        }
+        teken = (teken << 6) | (p[i] & 0x3F);
+    }
+
+    // te lange codering, surrogaat of voorbij U+10FFFF
+    if (teken < minimum || teken > 0x10FFFF || (teken >= 0xD800 && teken <= 0xDFFF)) {
+        return 0;
+    }
+
+    *codepunt = teken;
+    return lengte;
+}
+
+static size_t scalair_utf8(const char *buf, size_t bufsize, size_t offset)
+{
+    size_t i = offset;
+    while (i < bufsize) {
+        if ((unsigned char)buf[i] < 0x80) {
+            i++;
+            continue;
+        }
+
+        uint32_t codepunt;
+        size_t lengte = scan_utf8_teken(buf, bufsize, i, &codepunt);
+        if (lengte == 0) {
+            break;
+        }
+        i += lengte;
+    }
+    return i - offset;
+}
+
+/*
+ * Alles voor i is per blok gevalideerd, op een teken na dat over de grens bij
+ * i kan lopen. Terug naar het begin van het teken met de byte voor i en vanaf
+ * daar scalair verder, voor de precieze positie van een fout.
+ */
+static size_t scalair_utf8_vanaf_blok(const char *buf, size_t bufsize, size_t offset, size_t i)
+{
+    if (i == offset) {
+        return scalair_utf8(buf, bufsize, offset);
+    }
+
+    size_t j = i - 1;
+    while (j > offset && i - 1 - j < 3 && ((unsigned char)buf[j] & 0xC0) == 0x80) {
+        j--;
+    }
+    return j - offset + scalair_utf8(buf, bufsize, j);
+}
+
+#ifdef SCAN_X86
+
+/*
+ * (v - laag) < breedte als unsigned vergelijking. SSE2 en AVX2 kennen alleen
+ * signed vergelijkingen op bytes, dus het bereik wordt eerst naar -128
+ * verschoven.
+ */
+__attribute__((target("sse2")))
+static inline __m128i sse2_in_bereik(__m128i v, unsigned char laag, unsigned char breedte)
+{
+    __m128i verschoven = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - laag)));
+    return _mm_cmplt_epi8(verschoven, _mm_set1_epi8((char)(0x80 + breedte)));
+}
+
+// Bitmasker van de bytes die bij de soort horen
+__attribute__((target("sse2")))
+static inline unsigned int sse2_masker(__m128i v, SCAN_SOORT soort)
+{
+    __m128i klein = _mm_or_si128(v, _mm_set1_epi8(0x20));
+    __m128i cijfer = sse2_in_bereik(v, '0', 10);
+    __m128i m;
+
+    switch (soort) {
+        case SCAN_SOORT_SPATIES:
+            m = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+            break;
+        case SCAN_SOORT_NAAM:
+            m = _mm_or_si128(sse2_in_bereik(klein, 'a', 26), cijfer);
+            m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('-')));
+            m = _mm_or_si128(m, _mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
+            break;
+        case SCAN_SOORT_NUMMER:
+            m = _mm_or_si128(sse2_in_bereik(klein, 'a', 6), cijfer);
+            break;
+        case SCAN_SOORT_TEKENREEKS:
+        default:
+            m = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+            return ~(unsigned int)_mm_movemask_epi8(m) & 0xFFFF;
+    }
+    return (unsigned int)_mm_movemask_epi8(m);
+}
+
+__attribute__((target("sse2")))
+static inline size_t sse2_scan(const char *buf, size_t bufsize, size_t offset, SCAN_SOORT soort)
+{
+    size_t i = offset;
+    while (i + 16 <= bufsize) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(buf + i));
+        unsigned int stop = ~sse2_masker(v, soort) & 0xFFFF;
+        if (stop != 0) {
+            return i - offset + __builtin_ctz(stop);
+        }
+        i += 16;
+    }
+    return i - offset + scalair_scan(buf, bufsize, i, soort);
+}
+
+__attribute__((target("sse2")))
+static size_t sse2_spaties(const char *buf, size_t bufsize, size_t offset)
+{
+    return sse2_scan(buf, bufsize, offset, SCAN_SOORT_SPATIES);
+}
+
+__attribute__((target("sse2")))
+static size_t sse2_naam(const char *buf, size_t bufsize, size_t offset)
+{
+    return sse2_scan(buf, bufsize, offset, SCAN_SOORT_NAAM);
+}
+
+__attribute__((target("sse2")))
+static size_t sse2_nummer(const char *buf, size_t bufsize, size_t offset)
+{
+    return sse2_scan(buf, bufsize, offset, SCAN_SOORT_NUMMER);
+}
+
+__attribute__((target("sse2")))
+static size_t sse2_tekenreeks(const char *buf, size_t bufsize, size_t offset)
+{
+    return sse2_scan(buf, bufsize, offset, SCAN_SOORT_TEKENREEKS);
+}
+
+// ASCII-blokken worden in één keer overgeslagen, de rest gaat scalair
+__attribute__((target("sse2")))
+static size_t sse2_utf8(const char *buf, size_t bufsize, size_t offset)
+{
+    size_t i = offset;
+    while (i + 16 <= bufsize) {
+        unsigned int hoog = (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(buf + i)));
+        if (hoog == 0) {
+            i += 16;
+            continue;
+        }
+
+        i += __builtin_ctz(hoog);
+        uint32_t codepunt;
+        size_t lengte = scan_utf8_teken(buf, bufsize, i, &codepunt);
+        if (lengte == 0) {
+            return i - offset;
+        }
+        i += lengte;
+    }
+    return i - offset + scalair_utf8(buf, bufsize, i);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i avx2_in_bereik(__m256i v, unsigned char laag, unsigned char breedte)
+{
+    __m256i verschoven = _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - laag)));
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + breedte)), verschoven);
+}
+
+__attribute__((target("avx2")))
+static inline uint32_t avx2_masker(__m256i v, SCAN_SOORT soort)
+{
+    __m256i klein = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+    __m256i cijfer = avx2_in_bereik(v, '0', 10);
+    __m256i m;
+
+    switch (soort) {
+        case SCAN_SOORT_SPATIES:
+            m = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+            break;
+        case SCAN_SOORT_NAAM:
+            m = _mm256_or_si256(avx2_in_bereik(klein, 'a', 26), cijfer);
+            m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('-')));
+            m = _mm256_or_si256(m, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_')));
+            break;
+        case SCAN_SOORT_NUMMER:
+            m = _mm256_or_si256(avx2_in_bereik(klein, 'a', 6), cijfer);
+            break;
+        case SCAN_SOORT_TEKENREEKS:
+        default:
+            m = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+            return ~(uint32_t)_mm256_movemask_epi8(m);
+    }
+    return (uint32_t)_mm256_movemask_epi8(m);
+}
+
+__attribute__((target("avx2")))
+static inline size_t avx2_scan(const char *buf, size_t bufsize, size_t offset, SCAN_SOORT soort)
+{
+    size_t i = offset;
+    while (i + 32 <= bufsize) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(buf + i));
+        uint32_t stop = ~avx2_masker(v, soort);
+        if (stop != 0) {
+            return i - offset + __builtin_ctz(stop);
+        }
+        i += 32;
+    }
+    return i - offset + scalair_scan(buf, bufsize, i, soort);
+}
+
+__attribute__((target("avx2")))
+static size_t avx2_spaties(const char *buf, size_t bufsize, size_t offset)
+{
+    return avx2_scan(buf, bufsize, offset, SCAN_SOORT_SPATIES);
+}
+
+__attribute__((target("avx2")))
+static size_t avx2_naam(const char *buf, size_t bufsize, size_t offset)
+{
+    return avx2_scan(buf, bufsize, offset, SCAN_SOORT_NAAM);
+}
+
+__attribute__((target("avx2")))
+static size_t avx2_nummer(const char *buf, size_t bufsize, size_t offset)
+{
+    return avx2_scan(buf, bufsize, offset, SCAN_SOORT_NUMMER);
+}
+
+__attribute__((target("avx2")))
+static size_t avx2_tekenreeks(const char *buf, size_t bufsize, size_t offset)
+{
+    return avx2_scan(buf, bufsize, offset, SCAN_SOORT_TEKENREEKS);
+}
+
+/*
+ * UTF-8-validatie met opzoektabellen (Keiser en Lemire, "Validating UTF-8 in
+ * less than one instruction per byte"). Elke fout in een paar opeenvolgende
+ * bytes zet een bit in alle drie de tabellen: de hoge en lage helft van de
+ * vorige byte en de hoge helft van de huidige. Een derde of vierde byte van
+ * een teken wordt apart gecontroleerd met de bytes twee en drie terug.
+ */
+#define UTF8_TE_KORT      (1 << 0)
+#define UTF8_TE_LANG      (1 << 1)
+#define UTF8_TE_LANG_3    (1 << 2)
+#define UTF8_TE_GROOT     (1 << 3)
+#define UTF8_SURROGAAT    (1 << 4)
+#define UTF8_TE_LANG_2    (1 << 5)
+#define UTF8_TE_GROOT_1000 (1 << 6)
+#define UTF8_TE_LANG_4    (1 << 6)
+#define UTF8_TWEE_VERVOLG (1 << 7)
+#define UTF8_DOOR (UTF8_TE_KORT | UTF8_TE_LANG | UTF8_TWEE_VERVOLG)
+
+#define T16(a, b, c, d, e, f, g, h, i, j, k, l, m, n, o, p) \
+    (char)(a), (char)(b), (char)(c), (char)(d), (char)(e), (char)(f), (char)(g), (char)(h), \
+    (char)(i), (char)(j), (char)(k), (char)(l), (char)(m), (char)(n), (char)(o), (char)(p)
+
+#define UTF8_BYTE_1_HOOG T16( \
+    UTF8_TE_LANG, UTF8_TE_LANG, UTF8_TE_LANG, UTF8_TE_LANG, \
+    UTF8_TE_LANG, UTF8_TE_LANG, UTF8_TE_LANG, UTF8_TE_LANG, \
+    UTF8_TWEE_VERVOLG, UTF8_TWEE_VERVOLG, UTF8_TWEE_VERVOLG, UTF8_TWEE_VERVOLG, \
+    UTF8_TE_KORT | UTF8_TE_LANG_2, \
+    UTF8_TE_KORT, \
+    UTF8_TE_KORT | UTF8_TE_LANG_3 | UTF8_SURROGAAT, \
+    UTF8_TE_KORT | UTF8_TE_GROOT | UTF8_TE_GROOT_1000 | UTF8_TE_LANG_4)
+
+#define UTF8_BYTE_1_LAAG T16( \
+    UTF8_DOOR | UTF8_TE_LANG_3 | UTF8_TE_LANG_2 | UTF8_TE_LANG_4, \
+    UTF8_DOOR | UTF8_TE_LANG_2, \
+    UTF8_DOOR, \
+    UTF8_DOOR, \
+    UTF8_DOOR | UTF8_TE_GROOT, \
+    UTF8_DOOR | UTF8_TE_GROOT | UTF8_TE_GROOT_1000, \
+    UTF8_DOOR | UTF8_TE_GROOT | UTF8_TE_GROOT_1000, \
+    UTF8_DOOR | UTF8_TE_GROOT | UTF8_TE_GROOT_1000, \
+    UTF8_DOOR | UTF8_TE_GROOT | UTF8_TE_GROOT_1000, \
+    UTF8_DOOR | UTF8_TE_GROOT | UTF8_TE_GROOT_1000, \
+    UTF8_DOOR | UTF8_TE_GROOT | UTF8_TE_GROOT_1000, \
+    UTF8_DOOR | UTF8_TE_GROOT | UTF8_TE_GROOT_1000, \
+    UTF8_DOOR | UTF8_TE_GROOT | UTF8_TE_GROOT_1000, \
+    UTF8_DOOR | UTF8_TE_GROOT | UTF8_TE_GROOT_1000 | UTF8_SURROGAAT, \
+    UTF8_DOOR | UTF8_TE_GROOT | UTF8_TE_GROOT_1000, \
+    UTF8_DOOR | UTF8_TE_GROOT | UTF8_TE_GROOT_1000)
+
+#define UTF8_BYTE_2_HOOG T16( \
+    UTF8_TE_KORT, UTF8_TE_KORT, UTF8_TE_KORT, UTF8_TE_KORT, \
+    UTF8_TE_KORT, UTF8_TE_KORT, UTF8_TE_KORT, UTF8_TE_KORT, \
+    UTF8_TE_LANG | UTF8_TE_LANG_2 | UTF8_TWEE_VERVOLG | UTF8_TE_LANG_3 | UTF8_TE_GROOT_1000 | UTF8_TE_LANG_4, \
+    UTF8_TE_LANG | UTF8_TE_LANG_2 | UTF8_TWEE_VERVOLG | UTF8_TE_LANG_3 | UTF8_TE_GROOT, \
+    UTF8_TE_LANG | UTF8_TE_LANG_2 | UTF8_TWEE_VERVOLG | UTF8_SURROGAAT | UTF8_TE_GROOT, \
+    UTF8_TE_LANG | UTF8_TE_LANG_2 | UTF8_TWEE_VERVOLG | UTF8_SURROGAAT | UTF8_TE_GROOT, \
+    UTF8_TE_KORT, UTF8_TE_KORT, UTF8_TE_KORT, UTF8_TE_KORT)
+
+// De bytes van v, n plaatsen opgeschoven met de laatste bytes van vorige ervoor
+#define AVX2_VORIGE(v, vorige, n) \
+    _mm256_alignr_epi8((v), _mm256_permute2x128_si256((vorige), (v), 0x21), 16 - (n))
+
+__attribute__((target("avx2")))
+static inline __m256i avx2_utf8_fouten(__m256i v, __m256i vorige)
+{
+    __m256i laag_nibble = _mm256_set1_epi8(0x0F);
+    __m256i vorige1 = AVX2_VORIGE(v, vorige, 1);
+
+    __m256i byte_1_hoog = _mm256_shuffle_epi8(_mm256_setr_epi8(UTF8_BYTE_1_HOOG, UTF8_BYTE_1_HOOG),
+        _mm256_and_si256(_mm256_srli_epi16(vorige1, 4), laag_nibble));
+    __m256i byte_1_laag = _mm256_shuffle_epi8(_mm256_setr_epi8(UTF8_BYTE_1_LAAG, UTF8_BYTE_1_LAAG),
+        _mm256_and_si256(vorige1, laag_nibble));
+    __m256i byte_2_hoog = _mm256_shuffle_epi8(_mm256_setr_epi8(UTF8_BYTE_2_HOOG, UTF8_BYTE_2_HOOG),
+        _mm256_and_si256(_mm256_srli_epi16(v, 4), laag_nibble));
+    __m256i bijzonder = _mm256_and_si256(_mm256_and_si256(byte_1_hoog, byte_1_laag), byte_2_hoog);
+
+    // alleen 111_____ twee terug of 1111____ drie terug komt boven 0x80
+    __m256i derde = _mm256_subs_epu8(AVX2_VORIGE(v, vorige, 2), _mm256_set1_epi8((char)(0xE0 - 0x80)));
+    __m256i vierde = _mm256_subs_epu8(AVX2_VORIGE(v, vorige, 3), _mm256_set1_epi8((char)(0xF0 - 0x80)));
+    __m256i moet_vervolg = _mm256_and_si256(_mm256_or_si256(derde, vierde), _mm256_set1_epi8((char)0x80));
+
+    return _mm256_xor_si256(moet_vervolg, bijzonder);
+}
+
+// Niet-nul als het blok eindigt midden in een teken
+__attribute__((target("avx2")))
+static inline __m256i avx2_utf8_onvolledig(__m256i v)
+{
+    __m256i maximum = _mm256_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        (char)(0xF0 - 1), (char)(0xE0 - 1), (char)(0xC0 - 1));
+    return _mm256_subs_epu8(v, maximum);
+}
+
+__attribute__((target("avx2")))
+static size_t avx2_utf8(const char *buf, size_t bufsize, size_t offset)
+{
+    size_t i = offset;
+    __m256i vorige = _mm256_setzero_si256();
+    while (i + 32 <= bufsize) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(buf + i));
+        __m256i fout;
+        if (_mm256_movemask_epi8(v) == 0) {
+            fout = avx2_utf8_onvolledig(vorige);
+        } else {
+            fout = avx2_utf8_fouten(v, vorige);
+        }
+        if (!_mm256_testz_si256(fout, fout)) {
+            break;
+        }
+        vorige = v;
+        i += 32;
+    }
+    // de rest, en een teken dat over het laatste blok heen loopt
+    return scalair_utf8_vanaf_blok(buf, bufsize, offset, i);
+}
+
+#endif
+
+typedef size_t (*scan_functie)(const char *buf, size_t bufsize, size_t offset);
+
+typedef struct {
+    scan_functie spaties;
+    scan_functie naam;
+    scan_functie nummer;
+    scan_functie tekenreeks;
+    scan_functie utf8;
+} scan_functies;
+
+static const scan_functies scan_scalair = {
+    scalair_spaties, scalair_naam, scalair_nummer, scalair_tekenreeks, scalair_utf8
+};
+
+#ifdef SCAN_X86
+static const scan_functies scan_sse2 = {
+    sse2_spaties, sse2_naam, sse2_nummer, sse2_tekenreeks, sse2_utf8
+};
+
+static const scan_functies scan_avx2 = {
+    avx2_spaties, avx2_naam, avx2_nummer, avx2_tekenreeks, avx2_utf8
+};
+#endif
+
+static const scan_functies *scan_actief = &scan_scalair;
+
+SCAN_ISA scan_beste_isa(void)
+{
+#ifdef SCAN_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SCAN_ISA_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return SCAN_ISA_SSE2;
+    }
+#endif
+    return SCAN_ISA_SCALAIR;
+}
+
+SCAN_ISA scan_kies_isa(SCAN_ISA isa)
+{
+    if (isa > scan_beste_isa()) {
+        isa = scan_beste_isa();
+    }
+
+    switch (isa) {
+#ifdef SCAN_X86
+        case SCAN_ISA_AVX2:
+            scan_actief = &scan_avx2;
+            break;
+        case SCAN_ISA_SSE2:
+            scan_actief = &scan_sse2;
+            break;
+#endif
+        default:
+            scan_actief = &scan_scalair;
+            isa = SCAN_ISA_SCALAIR;
+            break;
+    }
+
+    return isa;
+}
+
+const char* scan_isa_naam(SCAN_ISA isa)
+{
+    switch (isa) {
+        case SCAN_ISA_AVX2:
+            return "avx2";
+        case SCAN_ISA_SSE2:
+            return "sse2";
+        default:
+            return "scalair";
+    }
+}
+
+#ifdef SCAN_X86
+// Kies de breedste ISA voordat main begint, zodat de lexer nooit hoeft te controleren
+__attribute__((constructor))
+static void scan_init(void)
+{
+    scan_kies_isa(scan_beste_isa());
+}
+#endif
+
+size_t scan_spaties(const char *buf, size_t bufsize, size_t offset)
+{
+    return scan_actief->spaties(buf, bufsize, offset);
+}
+
+size_t scan_naam(const char *buf, size_t bufsize, size_t offset)
+{
+    return scan_actief->naam(buf, bufsize, offset);
+}
+
+size_t scan_nummer(const char *buf, size_t bufsize, size_t offset)
+{
+    return scan_actief->nummer(buf, bufsize, offset);
+}
+
+size_t scan_tekenreeks(const char *buf, size_t bufsize, size_t offset)
+{
+    return scan_actief->tekenreeks(buf, bufsize, offset);
+}
+
+size_t scan_utf8(const char *buf, size_t bufsize, size_t offset)
+{
+    return scan_actief->utf8(buf, bufsize, offset);
+}
@@ -0,0 +1,50 @@
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Snelle scan-laag voor de lexer. Elke functie geeft het aantal bytes vanaf
+ * offset terug dat tot de betreffende klasse hoort (of, bij
+ * scan_tekenreeks, tot de eerste '"' of '\\', en bij scan_utf8 tot het eerste
+ * ongeldige of onvolledige UTF-8-teken). De SIMD-varianten bekijken 16 of 32
+ * bytes tegelijk; het resultaat is byte voor byte gelijk aan de scalaire
+ * versie.
+ */
+
+typedef enum {
+    SCAN_ISA_SCALAIR,
+    SCAN_ISA_SSE2,
+    SCAN_ISA_AVX2,
+} SCAN_ISA;
+
+// Tekenklassen, onafhankelijk van de locale
+#define SCAN_KLASSE_LETTER  0x01
+#define SCAN_KLASSE_CIJFER  0x02
+#define SCAN_KLASSE_HEX     0x04
+#define SCAN_KLASSE_NAAM    0x08
+
+extern const uint8_t scan_klassen[256];
+
+static inline int scan_is(unsigned char c, uint8_t klasse)
+{
+    return scan_klassen[c] & klasse;
+}
+
+size_t scan_spaties(const char *buf, size_t bufsize, size_t offset);
+size_t scan_naam(const char *buf, size_t bufsize, size_t offset);
+size_t scan_nummer(const char *buf, size_t bufsize, size_t offset);
+size_t scan_tekenreeks(const char *buf, size_t bufsize, size_t offset);
+size_t scan_utf8(const char *buf, size_t bufsize, size_t offset);
+
+// Leest één UTF-8-teken; geeft de lengte terug, of 0 als het ongeldig of onvolledig is
+size_t scan_utf8_teken(const char *buf, size_t bufsize, size_t offset, uint32_t *codepunt);
+
+// De breedste ISA die deze processor ondersteunt
+SCAN_ISA scan_beste_isa(void);
+// Kies een ISA; geeft de werkelijk gekozen ISA terug als deze niet beschikbaar is
+SCAN_ISA scan_kies_isa(SCAN_ISA isa);
+const char* scan_isa_naam(SCAN_ISA isa);
+
+#endif
@@ -0,0 +1,236 @@
+#define _GNU_SOURCE
+#include "statistiek.h"
+#include <inttypes.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif
+
+static const char *teller_namen[STAT_TELLERS] = {
+    "cycli",
+    "instructies",
+    "sprongmissers",
+    "cachemissers",
+};
+
+#ifdef __linux__
+static int open_teller(uint64_t config)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // ook de threads die deze thread hierna start, zoals die van de parallelle lexer en parser
+    attr.inherit = 1;
+
+    // deze thread, op elke processor
+    return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+#endif
+
+void stat_init(STATISTIEK *stat, const GEHEUGEN *geheugen)
+{
+    memset(stat, 0, sizeof(STATISTIEK));
+    stat->geheugen = geheugen;
+    for (int t = 0; t < STAT_TELLERS; t++) {
+        stat->tellers_fd[t] = -1;
+    }
+
+#ifdef __linux__
+    static const uint64_t configs[STAT_TELLERS] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_BRANCH_MISSES,
+        PERF_COUNT_HW_CACHE_MISSES,
+    };
+    for (int t = 0; t < STAT_TELLERS; t++) {
+        stat->tellers_fd[t] = open_teller(configs[t]);
+    }
+#endif
+}
+
+void stat_sluit(STATISTIEK *stat)
+{
+    for (int t = 0; t < STAT_TELLERS; t++) {
+        if (stat->tellers_fd[t] >= 0) {
+            close(stat->tellers_fd[t]);
+            stat->tellers_fd[t] = -1;
+        }
+    }
+}
+
+static void lees_tellers(STATISTIEK *stat, uint64_t *tellers)
+{
+    for (int t = 0; t < STAT_TELLERS; t++) {
+        tellers[t] = 0;
+        if (stat->tellers_fd[t] >= 0 && read(stat->tellers_fd[t], &tellers[t], sizeof(uint64_t)) != sizeof(uint64_t)) {
+            // werkt niet (meer): dan helemaal niet rapporteren
+            close(stat->tellers_fd[t]);
+            stat->tellers_fd[t] = -1;
+        }
+    }
+}
+
+static double verschil_ms(struct timespec begin, struct timespec eind)
+{
+    return (eind.tv_sec - begin.tv_sec) * 1e3 + (eind.tv_nsec - begin.tv_nsec) / 1e6;
+}
+
+void stat_begin(STATISTIEK *stat, const char *fase)
+{
+    if (stat->fasen_size == STAT_MAX_FASEN) {
+        return;
+    }
+    stat->fasen[stat->fasen_size].naam = fase;
+
+    stat->geheugen_begin = geheugen_stand(stat->geheugen, GEHEUGEN_SOORTEN);
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &stat->cpu_begin);
+    clock_gettime(CLOCK_MONOTONIC, &stat->wand_begin);
+    // als laatste, zodat het meten zelf zo min mogelijk meetelt
+    lees_tellers(stat, stat->tellers_begin);
+}
+
+void stat_eind(STATISTIEK *stat)
+{
+    uint64_t tellers[STAT_TELLERS];
+    lees_tellers(stat, tellers);
+    struct timespec wand, cpu;
+    clock_gettime(CLOCK_MONOTONIC, &wand);
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu);
+    GEHEUGEN_STAND geheugen = geheugen_stand(stat->geheugen, GEHEUGEN_SOORTEN);
+
+    if (stat->fasen_size == STAT_MAX_FASEN) {
+        return;
+    }
+    STAT_FASE *fase = &stat->fasen[stat->fasen_size++];
+    fase->wand_ms = verschil_ms(stat->wand_begin, wand);
+    fase->cpu_ms = verschil_ms(stat->cpu_begin, cpu);
+    fase->allocaties = geheugen.allocaties - stat->geheugen_begin.allocaties;
+    fase->bytes = geheugen.bytes - stat->geheugen_begin.bytes;
+    for (int t = 0; t < STAT_TELLERS; t++) {
+        fase->tellers[t] = tellers[t] - stat->tellers_begin[t];
+    }
+}
+
+static void print_json_tekst(FILE *uit, const char *tekst)
+{
+    fputc('"', uit);
+    for (const unsigned char *c = (const unsigned char*)tekst; *c; c++) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(uit, "\\%c", *c);
+        } else if (*c < 0x20) {
+            fprintf(uit, "\\u%04x", *c);
+        } else {
+            fputc(*c, uit);
+        }
+    }
+    fputc('"', uit);
+}
+
+void stat_print(const STATISTIEK *stat, FILE *uit, bool json, const char *bestand, const STAT_OMVANG *omvang, const GEHEUGEN *geheugen)
+{
+    // de interntabel is van het hele proces en zit altijd in geheugen_standaard
+    GEHEUGEN_STAND teksten = geheugen_stand(&geheugen_standaard, GEHEUGEN_TEKSTEN);
+
+    struct rusage gebruik;
+    long piek_kb = getrusage(RUSAGE_SELF, &gebruik) == 0 ? gebruik.ru_maxrss : 0;
+
+    STAT_FASE totaal = { .naam = "totaal" };
+    for (size_t f = 0; f < stat->fasen_size; f++) {
+        totaal.wand_ms += stat->fasen[f].wand_ms;
+        totaal.cpu_ms += stat->fasen[f].cpu_ms;
+        totaal.allocaties += stat->fasen[f].allocaties;
+        totaal.bytes += stat->fasen[f].bytes;
+        for (int t = 0; t < STAT_TELLERS; t++) {
+            totaal.tellers[t] += stat->fasen[f].tellers[t];
+        }
+    }
+
+    if (json) {
+        fprintf(uit, "{\"bestand\":");
+        print_json_tekst(uit, bestand);
+        fprintf(uit, ",\"symbolen\":%zu,\"knopen\":%zu,", omvang->symbolen, omvang->knopen);
+        if (omvang->delen) {
+            fprintf(uit, "\"gedeeld\":%" PRIu64 ",", omvang->gedeeld);
+        }
+        if (omvang->passen_size > 0) {
+            fprintf(uit, "\"passen\":{");
+            for (size_t p = 0; p < omvang->passen_size; p++) {
+                fprintf(uit, "%s", p == 0 ? "" : ",");
+                print_json_tekst(uit, omvang->passen[p].naam);
+                fprintf(uit, ":%zu", omvang->passen[p].verwijderd);
+            }
+            fprintf(uit, "},");
+        }
+        fprintf(uit, "\"piek_rss_kb\":%ld,\"fasen\":[", piek_kb);
+        for (size_t f = 0; f <= stat->fasen_size; f++) {
+            const STAT_FASE *fase = f < stat->fasen_size ? &stat->fasen[f] : &totaal;
+            fprintf(uit, "%s{\"naam\":\"%s\",\"wand_ms\":%.3f,\"cpu_ms\":%.3f,\"allocaties\":%" PRIu64 ",\"bytes\":%" PRIu64,
+                f == 0 ? "" : ",", fase->naam, fase->wand_ms, fase->cpu_ms, fase->allocaties, fase->bytes);
+            for (int t = 0; t < STAT_TELLERS; t++) {
+                if (stat->tellers_fd[t] >= 0) {
+                    fprintf(uit, ",\"%s\":%" PRIu64, teller_namen[t], fase->tellers[t]);
+                }
+            }
+            fputc('}', uit);
+        }
+        fprintf(uit, "],\"geheugen\":{");
+        for (int s = 0; s <= GEHEUGEN_SOORTEN; s++) {
+            GEHEUGEN_STAND stand = geheugen_stand(geheugen, s);
+            fprintf(uit, "%s\"%s\":{\"allocaties\":%" PRIu64 ",\"live\":%" PRIu64 ",\"piek\":%" PRIu64 "}",
+                s == 0 ? "" : ",", geheugen_soort_naam(s), stand.allocaties, stand.live, stand.piek);
+        }
+        fprintf(uit, "},\"interntabel\":{\"live\":%" PRIu64 ",\"piek\":%" PRIu64 "}}\n", teksten.live, teksten.piek);
+        return;
+    }
+
+    fprintf(uit, "Statistiek voor %s\n", bestand);
+    fprintf(uit, "  symbolen: %zu, knopen: %zu, piek-RSS: %ld kB\n", omvang->symbolen, omvang->knopen, piek_kb);
+    if (omvang->delen) {
+        fprintf(uit, "  delen: %" PRIu64 " knopen hergebruikt\n", omvang->gedeeld);
+    }
+    for (size_t p = 0; p < omvang->passen_size; p++) {
+        fprintf(uit, "  pas %s: %zu knopen weg\n", omvang->passen[p].naam, omvang->passen[p].verwijderd);
+    }
+    fprintf(uit, "  %-10s %12s %12s %12s %14s", "fase", "wand (ms)", "cpu (ms)", "allocaties", "bytes");
+    for (int t = 0; t < STAT_TELLERS; t++) {
+        if (stat->tellers_fd[t] >= 0) {
+            fprintf(uit, " %14s", teller_namen[t]);
+        }
+    }
+    fputc('\n', uit);
+    for (size_t f = 0; f <= stat->fasen_size; f++) {
+        const STAT_FASE *fase = f < stat->fasen_size ? &stat->fasen[f] : &totaal;
+        fprintf(uit, "  %-10s %12.3f %12.3f %12" PRIu64 " %14" PRIu64,
+            fase->naam, fase->wand_ms, fase->cpu_ms, fase->allocaties, fase->bytes);
+        for (int t = 0; t < STAT_TELLERS; t++) {
+            if (stat->tellers_fd[t] >= 0) {
+                fprintf(uit, " %14" PRIu64, fase->tellers[t]);
+            }
+        }
+        fputc('\n', uit);
+    }
+    bool tellers = false;
+    for (int t = 0; t < STAT_TELLERS; t++) {
+        tellers = tellers || stat->tellers_fd[t] >= 0;
+    }
+    if (!tellers) {
+        fprintf(uit, "  (geen hardwaretellers: perf_event_open is niet beschikbaar)\n");
+    }
+
+    fprintf(uit, "  %-10s %12s %12s %12s\n", "geheugen", "allocaties", "live", "piek");
+    for (int s = 0; s <= GEHEUGEN_SOORTEN; s++) {
+        GEHEUGEN_STAND stand = geheugen_stand(geheugen, s);
+        if (stand.allocaties > 0 || s == GEHEUGEN_SOORTEN) {
+            fprintf(uit, "  %-10s %12" PRIu64 " %12" PRIu64 " %12" PRIu64 "\n", geheugen_soort_naam(s), stand.allocaties, stand.live, stand.piek);
+        }
+    }
+    fprintf(uit, "  interntabel (gedeeld): %" PRIu64 " bytes, piek %" PRIu64 "\n", teksten.live, teksten.piek);
+}
@@ -0,0 +1,86 @@
+#ifndef STATISTIEK_H
+#define STATISTIEK_H
+
+#include "geheugen.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+/*
+ * Metingen per fase (lexen, parsen, uitvoeren) voor --stats: wandtijd,
+ * CPU-tijd, allocaties, en waar perf_event_open mag de hardwaretellers. Een
+ * teller die niet geopend kan worden blijft weg uit het verslag; de rest
+ * werkt gewoon. Aan het einde komt per soort het geheugen dat nog in gebruik
+ * is en het maximum.
+ *
+ * De threads van de parallelle lexer en parser tellen mee: de allocaties
+ * komen uit de allocator van het bestand, de hardwaretellers gaan over op
+ * threads die na stat_init gestart worden, en de CPU-tijd is die van het
+ * hele proces. Met meerdere bestanden tegelijk (--lijst) zit in die
+ * CPU-tijd dus ook het werk aan de andere bestanden.
+ */
+
+typedef enum {
+    STAT_CYCLI,
+    STAT_INSTRUCTIES,
+    STAT_SPRONG_MISSERS,
+    STAT_CACHE_MISSERS,
+    STAT_TELLERS,
+} STAT_TELLER;
+
+#define STAT_MAX_FASEN 8
+#define STAT_MAX_PASSEN 8
+
+typedef struct {
+    const char *naam;
+    double wand_ms;
+    double cpu_ms;
+    uint64_t allocaties;
+    uint64_t bytes;
+    uint64_t tellers[STAT_TELLERS];
+} STAT_FASE;
+
+typedef struct {
+    // -1 als de teller niet beschikbaar is
+    int tellers_fd[STAT_TELLERS];
+    const GEHEUGEN *geheugen;
+
+    STAT_FASE fasen[STAT_MAX_FASEN];
+    size_t fasen_size;
+
+    // stand aan het begin van de huidige fase
+    struct timespec wand_begin;
+    struct timespec cpu_begin;
+    GEHEUGEN_STAND geheugen_begin;
+    uint64_t tellers_begin[STAT_TELLERS];
+} STATISTIEK;
+
+// Opent de tellers voor de aanroepende thread en wat die daarna start; allocaties komen uit geheugen
+void stat_init(STATISTIEK *stat, const GEHEUGEN *geheugen);
+void stat_sluit(STATISTIEK *stat);
+
+void stat_begin(STATISTIEK *stat, const char *fase);
+void stat_eind(STATISTIEK *stat);
+
+// Omvang van de invoer en wat de parser deed
+typedef struct {
+    size_t symbolen;
+    size_t knopen;
+    // alleen gerapporteerd met --delen: hoe vaak de parser een bestaande knoop hergebruikte
+    bool delen;
+    uint64_t gedeeld;
+
+    // per optimalisatiepas hoeveel knopen die weghaalde, als er geoptimaliseerd is
+    struct {
+        const char *naam;
+        size_t verwijderd;
+    } passen[STAT_MAX_PASSEN];
+    size_t passen_size;
+} STAT_OMVANG;
+
+// Een tabel voor mensen, of met json één JSON-object op één regel
+void stat_print(const STATISTIEK *stat, FILE *uit, bool json, const char *bestand, const STAT_OMVANG *omvang, const GEHEUGEN *geheugen);
+
+#endif
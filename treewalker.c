@@ -1,130 +1,155 @@
 #include "treewalker.h"
+#include "flat.h"
+#include "geheugen.h"
 #include "parser.h"
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
 
-typedef enum {
-    VARIABLE_TYPE_NONE,
-    VARIABLE_TYPE_NUM,
-    VARIABLE_TYPE_STR,
-} VARIABLE_TYPE;
-
-typedef struct {
-    char *identifier;
-    VARIABLE_TYPE type;
-    union {
-        uint32_t number;
-        char *str;
-    };
-} VARIABLE;
-
-static VARIABLE *vars = NULL;
-static size_t vars_size = 0;
-
-VARIABLE* get_variable(char *identifier)
+VARIABLE* get_variable(const OMGEVING *omgeving, INTERN_ATOOM identifier)
 {
-    for (size_t i = 0; i < vars_size; i++) {
-        if (strcmp(identifier, vars[i].identifier) == 0) {
-            return &vars[i];
+    for (size_t i = 0; i < omgeving->vars_size; i++) {
+        if (omgeving->vars[i].identifier == identifier) {
+            return &omgeving->vars[i];
         }
     }
 
     return NULL;
 }
 
-void set_num_variable(char *identifier, uint32_t num)
+VARIABLE* add_variable(OMGEVING *omgeving, INTERN_ATOOM identifier)
 {
-    VARIABLE *var = get_variable(identifier);
-    if (var == NULL) {
-        vars_size += 1;
-        vars = realloc(vars, sizeof(VARIABLE) * vars_size);
-
-        vars[vars_size - 1].type = VARIABLE_TYPE_NUM;
+    omgeving->vars_size += 1;
+    omgeving->vars = geheugen_realloc(omgeving->geheugen, GEHEUGEN_VARIABELEN, omgeving->vars, sizeof(VARIABLE) * omgeving->vars_size);
+    omgeving->vars[omgeving->vars_size - 1].identifier = identifier;
 
-        vars[vars_size - 1].identifier = malloc(strlen(identifier) + 1);
-        strcpy(vars[vars_size - 1].identifier, identifier);
+    return &omgeving->vars[omgeving->vars_size - 1];
+}
 
-        vars[vars_size - 1].number = num;
-    } else {
-        if (var->type == VARIABLE_TYPE_STR && var->str != NULL) {
-            free(var->str);
-        }
+// The variable to assign to, without its old value
+static VARIABLE* assign_variable(OMGEVING *omgeving, INTERN_ATOOM identifier)
+{
+    VARIABLE *var = get_variable(omgeving, identifier);
+    if (var == NULL) {
+        return add_variable(omgeving, identifier);
+    }
 
-        var->type = VARIABLE_TYPE_NUM;
-        var->number = num;
+    if (var->type == VARIABLE_TYPE_HOST_STR) {
+        geheugen_vrij(var->host_str.text);
     }
+    return var;
 }
 
-void set_str_variable(char *identifier, char *str)
+void set_num_variable(OMGEVING *omgeving, INTERN_ATOOM identifier, uint32_t num)
 {
-    VARIABLE *var = get_variable(identifier);
-    if (var == NULL) {
-        vars_size += 1;
-        vars = realloc(vars, sizeof(VARIABLE) * vars_size);
+    VARIABLE *var = assign_variable(omgeving, identifier);
+    var->type = VARIABLE_TYPE_NUM;
+    var->number = num;
+}
 
-        vars[vars_size - 1].type = VARIABLE_TYPE_STR;
+void set_str_variable(OMGEVING *omgeving, INTERN_ATOOM identifier, INTERN_ATOOM str)
+{
+    VARIABLE *var = assign_variable(omgeving, identifier);
+    var->type = VARIABLE_TYPE_STR;
+    var->str = str;
+}
 
-        vars[vars_size - 1].identifier = malloc(strlen(identifier) + 1);
-        strcpy(vars[vars_size - 1].identifier, identifier);
+void set_host_str_variable(OMGEVING *omgeving, INTERN_ATOOM identifier, const char *str, size_t size)
+{
+    char *text = geheugen_alloc(omgeving->geheugen, GEHEUGEN_VARIABELEN, size + 1);
+    memcpy(text, str, size);
+    text[size] = '\0';
 
-        vars[vars_size - 1].str = malloc(strlen(str) + 1);
-        strcpy(vars[vars_size - 1].str, str);
-    } else {
-        if (var->type == VARIABLE_TYPE_STR && var->str != NULL) {
-            free(var->str);
-        }
+    VARIABLE *var = assign_variable(omgeving, identifier);
+    var->type = VARIABLE_TYPE_HOST_STR;
+    var->host_str.text = text;
+    var->host_str.size = size;
+}
 
-        var->type = VARIABLE_TYPE_STR;
-        var->str = malloc(strlen(str) + 1);
-        strcpy(var->str, str);
+bool get_num_variable(const OMGEVING *omgeving, INTERN_ATOOM identifier, uint32_t *num)
+{
+    VARIABLE *var = get_variable(omgeving, identifier);
+    if (var == NULL || var->type != VARIABLE_TYPE_NUM) {
+        return false;
     }
+
+    *num = var->number;
+    return true;
 }
 
-void print_all_variables()
+bool get_str_variable(const OMGEVING *omgeving, INTERN_ATOOM identifier, const char **str, size_t *size)
 {
-    for (size_t i = 0; i < vars_size; i++) {
-        printf("%s\n", vars[i].identifier);
+    VARIABLE *var = get_variable(omgeving, identifier);
+    if (var == NULL) {
+        return false;
+    }
+
+    if (var->type == VARIABLE_TYPE_STR) {
+        INTERN_TEKST text = intern_tekst(var->str);
+        *str = text.tekst;
+        *size = text.lengte;
+        return true;
+    }
+    if (var->type == VARIABLE_TYPE_HOST_STR) {
+        *str = var->host_str.text;
+        *size = var->host_str.size;
+        return true;
+    }
+    return false;
+}
+
+void print_all_variables(OMGEVING *omgeving)
+{
+    VARIABLE *vars = omgeving->vars;
+
+    fprintf(omgeving->uit, "VARS:\n");
+    for (size_t i = 0; i < omgeving->vars_size; i++) {
+        INTERN_TEKST identifier = intern_tekst(vars[i].identifier);
+        fprintf(omgeving->uit, "%.*s\n", (int)identifier.lengte, identifier.tekst);
         if (vars[i].type == VARIABLE_TYPE_NUM) {
-            printf("\t%u\n", vars[i].number);
+            fprintf(omgeving->uit, "\t%u\n", vars[i].number);
         } else if (vars[i].type == VARIABLE_TYPE_STR) {
-            printf("\t%s\n", vars[i].str);
+            INTERN_TEKST str = intern_tekst(vars[i].str);
+            fprintf(omgeving->uit, "\t%.*s\n", (int)str.lengte, str.tekst);
+        } else if (vars[i].type == VARIABLE_TYPE_HOST_STR) {
+            fprintf(omgeving->uit, "\t%.*s\n", (int)vars[i].host_str.size, vars[i].host_str.text);
         }
     }
 }
 
-uint32_t execute_operator(PARSER_NODE* node)
+uint32_t execute_operator(OMGEVING *omgeving, PARSER_NODE* node)
 {
     uint32_t left = 0;
     uint32_t right = 0;
 
     if (node->left->type == PARSER_TYPE_LITERAL) {
         if (node->left->literal != PARSER_LITERAL_NUMBER) {
-            printf("Can't do other types yet\n");
+            fprintf(omgeving->uit, "Can't do other types yet\n");
             return 0;
         }
 
         left = node->left->number;
     } else if (node->left->type == PARSER_TYPE_OPERATOR) {
-        left = execute_operator(node->left);
+        left = execute_operator(omgeving, node->left);
     } else {
-        printf("can't do other nodes yet\n");
+        fprintf(omgeving->uit, "can't do other nodes yet\n");
         return 0;
     }
 
     if (node->right->type == PARSER_TYPE_LITERAL) {
         if (node->right->literal != PARSER_LITERAL_NUMBER) {
-            printf("unsupported type\n");
+            fprintf(omgeving->uit, "unsupported type\n");
             return 0;
         }
 
         right = node->right->number;
     } else if (node->right->type == PARSER_TYPE_OPERATOR) {
-        right = execute_operator(node->right);
+        right = execute_operator(omgeving, node->right);
     } else {
-        printf("unsupported node\n");
+        fprintf(omgeving->uit, "unsupported node\n");
         return 0;
     }
 
@@ -138,55 +163,151 @@ uint32_t execute_operator(PARSER_NODE* node)
         case PARSER_OPERATOR_DIVIDE:
             return left / right;
         default:
-            printf("unsupported operator\n");
+            fprintf(omgeving->uit, "unsupported operator\n");
             return 0;
     }
 }
 
-void execute_node(PARSER_NODE *node)
+void execute_node(OMGEVING *omgeving, PARSER_NODE *node)
 {
     uint32_t result = 0;
     switch (node->type) {
         case PARSER_TYPE_ASSIGNMENT:
             if (node->right->type == PARSER_TYPE_OPERATOR) {
-                result = execute_operator(node->right);
-                set_num_variable(node->left->identifier, result);
+                result = execute_operator(omgeving, node->right);
+                set_num_variable(omgeving, node->left->identifier, result);
             } else if (node->right->type == PARSER_TYPE_LITERAL) {
                 if (node->right->literal == PARSER_LITERAL_NUMBER) {
-                    set_num_variable(node->left->identifier, node->right->number);
+                    set_num_variable(omgeving, node->left->identifier, node->right->number);
                 } else if (node->right->literal == PARSER_LITERAL_STRING) {
-                    set_str_variable(node->left->identifier, node->right->string);
+                    set_str_variable(omgeving, node->left->identifier, node->right->string);
                 }
             }
             break;
         case PARSER_TYPE_BODY:
-            treewalk(&node->body);
+            treewalk(omgeving, &node->body);
             break;
         case PARSER_TYPE_CONDITIONAL:
             if (node->expression->type == PARSER_TYPE_OPERATOR) {
-                result = execute_operator(node->expression);
+                result = execute_operator(omgeving, node->expression);
             } else if (node->expression->type == PARSER_TYPE_LITERAL) {
                 if (node->expression->literal == PARSER_LITERAL_NUMBER) {
                     result = node->expression->number;
                 }
             }
             if (result != 0 && node->right != NULL) {
-                execute_node(node->right);
+                execute_node(omgeving, node->right);
             } else if (result == 0 && node->left != NULL) {
-                execute_node(node->left);
+                execute_node(omgeving, node->left);
             }
             break;
         default:
-            printf("Onbekende node\n");
+            fprintf(omgeving->uit, "Onbekende node\n");
     }
 }
 
-void treewalk(PARSER_NODE_BODY *body)
+void treewalk(OMGEVING *omgeving, PARSER_NODE_BODY *body)
 {
     for (size_t i = 0; i < body->expressions_size; i++) {
-        execute_node(body->expressions[i]);
+        execute_node(omgeving, body->expressions[i]);
+    }
+}
+
+// The same as execute_operator, on the flat tree
+static uint32_t execute_flat_operator(OMGEVING *omgeving, const FLAT_TREE *tree, uint32_t node)
+{
+    uint32_t left = 0;
+    uint32_t right = 0;
+
+    uint32_t child = tree->left[node];
+    if (tree->type[child] == PARSER_TYPE_LITERAL) {
+        if (tree->kind[child] != PARSER_LITERAL_NUMBER) {
+            fprintf(omgeving->uit, "Can't do other types yet\n");
+            return 0;
+        }
+
+        left = tree->value[child];
+    } else if (tree->type[child] == PARSER_TYPE_OPERATOR) {
+        left = execute_flat_operator(omgeving, tree, child);
+    } else {
+        fprintf(omgeving->uit, "can't do other nodes yet\n");
+        return 0;
     }
 
-    printf("VARS:\n");
-    print_all_variables();
+    child = tree->right[node];
+    if (tree->type[child] == PARSER_TYPE_LITERAL) {
+        if (tree->kind[child] != PARSER_LITERAL_NUMBER) {
+            fprintf(omgeving->uit, "unsupported type\n");
+            return 0;
+        }
+
+        right = tree->value[child];
+    } else if (tree->type[child] == PARSER_TYPE_OPERATOR) {
+        right = execute_flat_operator(omgeving, tree, child);
+    } else {
+        fprintf(omgeving->uit, "unsupported node\n");
+        return 0;
+    }
+
+    switch (tree->kind[node]) {
+        case PARSER_OPERATOR_ADD:
+            return left + right;
+        case PARSER_OPERATOR_SUBTRACT:
+            return left - right;
+        case PARSER_OPERATOR_MULTIPLY:
+            return left * right;
+        case PARSER_OPERATOR_DIVIDE:
+            return left / right;
+        default:
+            fprintf(omgeving->uit, "unsupported operator\n");
+            return 0;
+    }
+}
+
+static void execute_flat_node(OMGEVING *omgeving, const FLAT_TREE *tree, uint32_t node)
+{
+    uint32_t result = 0;
+    uint32_t child;
+    switch (tree->type[node]) {
+        case PARSER_TYPE_ASSIGNMENT:
+            child = tree->right[node];
+            if (tree->type[child] == PARSER_TYPE_OPERATOR) {
+                result = execute_flat_operator(omgeving, tree, child);
+                set_num_variable(omgeving, tree->value[tree->left[node]], result);
+            } else if (tree->type[child] == PARSER_TYPE_LITERAL) {
+                if (tree->kind[child] == PARSER_LITERAL_NUMBER) {
+                    set_num_variable(omgeving, tree->value[tree->left[node]], tree->value[child]);
+                } else if (tree->kind[child] == PARSER_LITERAL_STRING) {
+                    set_str_variable(omgeving, tree->value[tree->left[node]], tree->value[child]);
+                }
+            }
+            break;
+        case PARSER_TYPE_BODY:
+            for (uint32_t i = 0; i < tree->right[node]; i++) {
+                execute_flat_node(omgeving, tree, tree->statements[tree->value[node] + i]);
+            }
+            break;
+        case PARSER_TYPE_CONDITIONAL:
+            child = tree->value[node];
+            if (tree->type[child] == PARSER_TYPE_OPERATOR) {
+                result = execute_flat_operator(omgeving, tree, child);
+            } else if (tree->type[child] == PARSER_TYPE_LITERAL) {
+                if (tree->kind[child] == PARSER_LITERAL_NUMBER) {
+                    result = tree->value[child];
+                }
+            }
+            if (result != 0 && tree->right[node] != FLAT_NONE) {
+                execute_flat_node(omgeving, tree, tree->right[node]);
+            } else if (result == 0 && tree->left[node] != FLAT_NONE) {
+                execute_flat_node(omgeving, tree, tree->left[node]);
+            }
+            break;
+        default:
+            fprintf(omgeving->uit, "Onbekende node\n");
+    }
+}
+
+void treewalk_flat(OMGEVING *omgeving, const FLAT_TREE *tree)
+{
+    execute_flat_node(omgeving, tree, tree->root);
 }
@@ -1,8 +1,25 @@
 #ifndef TREEWALKER_H
 #define TREEWALKER_H
 
+#include "flat.h"
+#include "omgeving.h"
 #include "parser.h"
 
-void treewalk(PARSER_NODE_BODY *body);
+// Runs the program with its variables in omgeving; diagnostics go to omgeving->uit
+void treewalk(OMGEVING *omgeving, PARSER_NODE_BODY *body);
+// Does the same as treewalk, directly from the flat tree
+void treewalk_flat(OMGEVING *omgeving, const FLAT_TREE *tree);
+// Prints every variable and its value to omgeving->uit, meant for once after the program has run
+void print_all_variables(OMGEVING *omgeving);
+
+// Variables as seen from the host: inputs before treewalk, results after it
+void set_num_variable(OMGEVING *omgeving, INTERN_ATOOM identifier, uint32_t num);
+void set_str_variable(OMGEVING *omgeving, INTERN_ATOOM identifier, INTERN_ATOOM str);
+// Copies str into omgeving->geheugen instead of the intern table; the copy goes when the variable changes or omgeving_vrij runs
+void set_host_str_variable(OMGEVING *omgeving, INTERN_ATOOM identifier, const char *str, size_t size);
+// false if the variable doesn't exist or holds another type
+bool get_num_variable(const OMGEVING *omgeving, INTERN_ATOOM identifier, uint32_t *num);
+// str is NUL-terminated and valid until the variable changes or omgeving_vrij runs
+bool get_str_variable(const OMGEVING *omgeving, INTERN_ATOOM identifier, const char **str, size_t *size);
 
 #endif
@@ -0,0 +1,385 @@
+#include "unicode.h"
+#include <stddef.h>
+
+#define UNICODE_NAAM 1
+#define UNICODE_NAAM_BEGIN 3
+
+typedef struct {
+    uint32_t begin;
+    uint16_t lengte; // laatste - begin
+    uint16_t soort;
+} unicode_bereik;
+
+/*
+ * Aaneengesloten bereiken vanaf U+0080 met dezelfde soort, oplopend
+ * gesorteerd; gemaakt uit XID_Start en XID_Continue van Unicode 14.0.
+ * UNICODE_NAAM_BEGIN mag ook vooraan een naam staan.
+ */
+static const unicode_bereik unicode_bereiken[] = {
+    { 0x00AA, 0, UNICODE_NAAM_BEGIN }, { 0x00B5, 0, UNICODE_NAAM_BEGIN }, { 0x00B7, 0, UNICODE_NAAM },
+    { 0x00BA, 0, UNICODE_NAAM_BEGIN }, { 0x00C0, 22, UNICODE_NAAM_BEGIN }, { 0x00D8, 30, UNICODE_NAAM_BEGIN },
+    { 0x00F8, 457, UNICODE_NAAM_BEGIN }, { 0x02C6, 11, UNICODE_NAAM_BEGIN }, { 0x02E0, 4, UNICODE_NAAM_BEGIN },
+    { 0x02EC, 0, UNICODE_NAAM_BEGIN }, { 0x02EE, 0, UNICODE_NAAM_BEGIN }, { 0x0300, 111, UNICODE_NAAM },
+    { 0x0370, 4, UNICODE_NAAM_BEGIN }, { 0x0376, 1, UNICODE_NAAM_BEGIN }, { 0x037B, 2, UNICODE_NAAM_BEGIN },
+    { 0x037F, 0, UNICODE_NAAM_BEGIN }, { 0x0386, 0, UNICODE_NAAM_BEGIN }, { 0x0387, 0, UNICODE_NAAM },
+    { 0x0388, 2, UNICODE_NAAM_BEGIN }, { 0x038C, 0, UNICODE_NAAM_BEGIN }, { 0x038E, 19, UNICODE_NAAM_BEGIN },
+    { 0x03A3, 82, UNICODE_NAAM_BEGIN }, { 0x03F7, 138, UNICODE_NAAM_BEGIN }, { 0x0483, 4, UNICODE_NAAM },
+    { 0x048A, 165, UNICODE_NAAM_BEGIN }, { 0x0531, 37, UNICODE_NAAM_BEGIN }, { 0x0559, 0, UNICODE_NAAM_BEGIN },
+    { 0x0560, 40, UNICODE_NAAM_BEGIN }, { 0x0591, 44, UNICODE_NAAM }, { 0x05BF, 0, UNICODE_NAAM },
+    { 0x05C1, 1, UNICODE_NAAM }, { 0x05C4, 1, UNICODE_NAAM }, { 0x05C7, 0, UNICODE_NAAM },
+    { 0x05D0, 26, UNICODE_NAAM_BEGIN }, { 0x05EF, 3, UNICODE_NAAM_BEGIN }, { 0x0610, 10, UNICODE_NAAM },
+    { 0x0620, 42, UNICODE_NAAM_BEGIN }, { 0x064B, 30, UNICODE_NAAM }, { 0x066E, 1, UNICODE_NAAM_BEGIN },
+    { 0x0670, 0, UNICODE_NAAM }, { 0x0671, 98, UNICODE_NAAM_BEGIN }, { 0x06D5, 0, UNICODE_NAAM_BEGIN },
+    { 0x06D6, 6, UNICODE_NAAM }, { 0x06DF, 5, UNICODE_NAAM }, { 0x06E5, 1, UNICODE_NAAM_BEGIN },
+    { 0x06E7, 1, UNICODE_NAAM }, { 0x06EA, 3, UNICODE_NAAM }, { 0x06EE, 1, UNICODE_NAAM_BEGIN },
+    { 0x06F0, 9, UNICODE_NAAM }, { 0x06FA, 2, UNICODE_NAAM_BEGIN }, { 0x06FF, 0, UNICODE_NAAM_BEGIN },
+    { 0x0710, 0, UNICODE_NAAM_BEGIN }, { 0x0711, 0, UNICODE_NAAM }, { 0x0712, 29, UNICODE_NAAM_BEGIN },
+    { 0x0730, 26, UNICODE_NAAM }, { 0x074D, 88, UNICODE_NAAM_BEGIN }, { 0x07A6, 10, UNICODE_NAAM },
+    { 0x07B1, 0, UNICODE_NAAM_BEGIN }, { 0x07C0, 9, UNICODE_NAAM }, { 0x07CA, 32, UNICODE_NAAM_BEGIN },
+    { 0x07EB, 8, UNICODE_NAAM }, { 0x07F4, 1, UNICODE_NAAM_BEGIN }, { 0x07FA, 0, UNICODE_NAAM_BEGIN },
+    { 0x07FD, 0, UNICODE_NAAM }, { 0x0800, 21, UNICODE_NAAM_BEGIN }, { 0x0816, 3, UNICODE_NAAM },
+    { 0x081A, 0, UNICODE_NAAM_BEGIN }, { 0x081B, 8, UNICODE_NAAM }, { 0x0824, 0, UNICODE_NAAM_BEGIN },
+    { 0x0825, 2, UNICODE_NAAM }, { 0x0828, 0, UNICODE_NAAM_BEGIN }, { 0x0829, 4, UNICODE_NAAM },
+    { 0x0840, 24, UNICODE_NAAM_BEGIN }, { 0x0859, 2, UNICODE_NAAM }, { 0x0860, 10, UNICODE_NAAM_BEGIN },
+    { 0x0870, 23, UNICODE_NAAM_BEGIN }, { 0x0889, 5, UNICODE_NAAM_BEGIN }, { 0x0898, 7, UNICODE_NAAM },
+    { 0x08A0, 41, UNICODE_NAAM_BEGIN }, { 0x08CA, 23, UNICODE_NAAM }, { 0x08E3, 32, UNICODE_NAAM },
+    { 0x0904, 53, UNICODE_NAAM_BEGIN }, { 0x093A, 2, UNICODE_NAAM }, { 0x093D, 0, UNICODE_NAAM_BEGIN },
+    { 0x093E, 17, UNICODE_NAAM }, { 0x0950, 0, UNICODE_NAAM_BEGIN }, { 0x0951, 6, UNICODE_NAAM },
+    { 0x0958, 9, UNICODE_NAAM_BEGIN }, { 0x0962, 1, UNICODE_NAAM }, { 0x0966, 9, UNICODE_NAAM },
+    { 0x0971, 15, UNICODE_NAAM_BEGIN }, { 0x0981, 2, UNICODE_NAAM }, { 0x0985, 7, UNICODE_NAAM_BEGIN },
+    { 0x098F, 1, UNICODE_NAAM_BEGIN }, { 0x0993, 21, UNICODE_NAAM_BEGIN }, { 0x09AA, 6, UNICODE_NAAM_BEGIN },
+    { 0x09B2, 0, UNICODE_NAAM_BEGIN }, { 0x09B6, 3, UNICODE_NAAM_BEGIN }, { 0x09BC, 0, UNICODE_NAAM },
+    { 0x09BD, 0, UNICODE_NAAM_BEGIN }, { 0x09BE, 6, UNICODE_NAAM }, { 0x09C7, 1, UNICODE_NAAM },
+    { 0x09CB, 2, UNICODE_NAAM }, { 0x09CE, 0, UNICODE_NAAM_BEGIN }, { 0x09D7, 0, UNICODE_NAAM },
+    { 0x09DC, 1, UNICODE_NAAM_BEGIN }, { 0x09DF, 2, UNICODE_NAAM_BEGIN }, { 0x09E2, 1, UNICODE_NAAM },
+    { 0x09E6, 9, UNICODE_NAAM }, { 0x09F0, 1, UNICODE_NAAM_BEGIN }, { 0x09FC, 0, UNICODE_NAAM_BEGIN },
+    { 0x09FE, 0, UNICODE_NAAM }, { 0x0A01, 2, UNICODE_NAAM }, { 0x0A05, 5, UNICODE_NAAM_BEGIN },
+    { 0x0A0F, 1, UNICODE_NAAM_BEGIN }, { 0x0A13, 21, UNICODE_NAAM_BEGIN }, { 0x0A2A, 6, UNICODE_NAAM_BEGIN },
+    { 0x0A32, 1, UNICODE_NAAM_BEGIN }, { 0x0A35, 1, UNICODE_NAAM_BEGIN }, { 0x0A38, 1, UNICODE_NAAM_BEGIN },
+    { 0x0A3C, 0, UNICODE_NAAM }, { 0x0A3E, 4, UNICODE_NAAM }, { 0x0A47, 1, UNICODE_NAAM },
+    { 0x0A4B, 2, UNICODE_NAAM }, { 0x0A51, 0, UNICODE_NAAM }, { 0x0A59, 3, UNICODE_NAAM_BEGIN },
+    { 0x0A5E, 0, UNICODE_NAAM_BEGIN }, { 0x0A66, 11, UNICODE_NAAM }, { 0x0A72, 2, UNICODE_NAAM_BEGIN },
+    { 0x0A75, 0, UNICODE_NAAM }, { 0x0A81, 2, UNICODE_NAAM }, { 0x0A85, 8, UNICODE_NAAM_BEGIN },
+    { 0x0A8F, 2, UNICODE_NAAM_BEGIN }, { 0x0A93, 21, UNICODE_NAAM_BEGIN }, { 0x0AAA, 6, UNICODE_NAAM_BEGIN },
+    { 0x0AB2, 1, UNICODE_NAAM_BEGIN }, { 0x0AB5, 4, UNICODE_NAAM_BEGIN }, { 0x0ABC, 0, UNICODE_NAAM },
+    { 0x0ABD, 0, UNICODE_NAAM_BEGIN }, { 0x0ABE, 7, UNICODE_NAAM }, { 0x0AC7, 2, UNICODE_NAAM },
+    { 0x0ACB, 2, UNICODE_NAAM }, { 0x0AD0, 0, UNICODE_NAAM_BEGIN }, { 0x0AE0, 1, UNICODE_NAAM_BEGIN },
+    { 0x0AE2, 1, UNICODE_NAAM }, { 0x0AE6, 9, UNICODE_NAAM }, { 0x0AF9, 0, UNICODE_NAAM_BEGIN },
+    { 0x0AFA, 5, UNICODE_NAAM }, { 0x0B01, 2, UNICODE_NAAM }, { 0x0B05, 7, UNICODE_NAAM_BEGIN },
+    { 0x0B0F, 1, UNICODE_NAAM_BEGIN }, { 0x0B13, 21, UNICODE_NAAM_BEGIN }, { 0x0B2A, 6, UNICODE_NAAM_BEGIN },
+    { 0x0B32, 1, UNICODE_NAAM_BEGIN }, { 0x0B35, 4, UNICODE_NAAM_BEGIN }, { 0x0B3C, 0, UNICODE_NAAM },
+    { 0x0B3D, 0, UNICODE_NAAM_BEGIN }, { 0x0B3E, 6, UNICODE_NAAM }, { 0x0B47, 1, UNICODE_NAAM },
+    { 0x0B4B, 2, UNICODE_NAAM }, { 0x0B55, 2, UNICODE_NAAM }, { 0x0B5C, 1, UNICODE_NAAM_BEGIN },
+    { 0x0B5F, 2, UNICODE_NAAM_BEGIN }, { 0x0B62, 1, UNICODE_NAAM }, { 0x0B66, 9, UNICODE_NAAM },
+    { 0x0B71, 0, UNICODE_NAAM_BEGIN }, { 0x0B82, 0, UNICODE_NAAM }, { 0x0B83, 0, UNICODE_NAAM_BEGIN },
+    { 0x0B85, 5, UNICODE_NAAM_BEGIN }, { 0x0B8E, 2, UNICODE_NAAM_BEGIN }, { 0x0B92, 3, UNICODE_NAAM_BEGIN },
+    { 0x0B99, 1, UNICODE_NAAM_BEGIN }, { 0x0B9C, 0, UNICODE_NAAM_BEGIN }, { 0x0B9E, 1, UNICODE_NAAM_BEGIN },
+    { 0x0BA3, 1, UNICODE_NAAM_BEGIN }, { 0x0BA8, 2, UNICODE_NAAM_BEGIN }, { 0x0BAE, 11, UNICODE_NAAM_BEGIN },
+    { 0x0BBE, 4, UNICODE_NAAM }, { 0x0BC6, 2, UNICODE_NAAM }, { 0x0BCA, 3, UNICODE_NAAM },
+    { 0x0BD0, 0, UNICODE_NAAM_BEGIN }, { 0x0BD7, 0, UNICODE_NAAM }, { 0x0BE6, 9, UNICODE_NAAM },
+    { 0x0C00, 4, UNICODE_NAAM }, { 0x0C05, 7, UNICODE_NAAM_BEGIN }, { 0x0C0E, 2, UNICODE_NAAM_BEGIN },
+    { 0x0C12, 22, UNICODE_NAAM_BEGIN }, { 0x0C2A, 15, UNICODE_NAAM_BEGIN }, { 0x0C3C, 0, UNICODE_NAAM },
+    { 0x0C3D, 0, UNICODE_NAAM_BEGIN }, { 0x0C3E, 6, UNICODE_NAAM }, { 0x0C46, 2, UNICODE_NAAM },
+    { 0x0C4A, 3, UNICODE_NAAM }, { 0x0C55, 1, UNICODE_NAAM }, { 0x0C58, 2, UNICODE_NAAM_BEGIN },
+    { 0x0C5D, 0, UNICODE_NAAM_BEGIN }, { 0x0C60, 1, UNICODE_NAAM_BEGIN }, { 0x0C62, 1, UNICODE_NAAM },
+    { 0x0C66, 9, UNICODE_NAAM }, { 0x0C80, 0, UNICODE_NAAM_BEGIN }, { 0x0C81, 2, UNICODE_NAAM },
+    { 0x0C85, 7, UNICODE_NAAM_BEGIN }, { 0x0C8E, 2, UNICODE_NAAM_BEGIN }, { 0x0C92, 22, UNICODE_NAAM_BEGIN },
+    { 0x0CAA, 9, UNICODE_NAAM_BEGIN }, { 0x0CB5, 4, UNICODE_NAAM_BEGIN }, { 0x0CBC, 0, UNICODE_NAAM },
+    { 0x0CBD, 0, UNICODE_NAAM_BEGIN }, { 0x0CBE, 6, UNICODE_NAAM }, { 0x0CC6, 2, UNICODE_NAAM },
+    { 0x0CCA, 3, UNICODE_NAAM }, { 0x0CD5, 1, UNICODE_NAAM }, { 0x0CDD, 1, UNICODE_NAAM_BEGIN },
+    { 0x0CE0, 1, UNICODE_NAAM_BEGIN }, { 0x0CE2, 1, UNICODE_NAAM }, { 0x0CE6, 9, UNICODE_NAAM },
+    { 0x0CF1, 1, UNICODE_NAAM_BEGIN }, { 0x0D00, 3, UNICODE_NAAM }, { 0x0D04, 8, UNICODE_NAAM_BEGIN },
+    { 0x0D0E, 2, UNICODE_NAAM_BEGIN }, { 0x0D12, 40, UNICODE_NAAM_BEGIN }, { 0x0D3B, 1, UNICODE_NAAM },
+    { 0x0D3D, 0, UNICODE_NAAM_BEGIN }, { 0x0D3E, 6, UNICODE_NAAM }, { 0x0D46, 2, UNICODE_NAAM },
+    { 0x0D4A, 3, UNICODE_NAAM }, { 0x0D4E, 0, UNICODE_NAAM_BEGIN }, { 0x0D54, 2, UNICODE_NAAM_BEGIN },
+    { 0x0D57, 0, UNICODE_NAAM }, { 0x0D5F, 2, UNICODE_NAAM_BEGIN }, { 0x0D62, 1, UNICODE_NAAM },
+    { 0x0D66, 9, UNICODE_NAAM }, { 0x0D7A, 5, UNICODE_NAAM_BEGIN }, { 0x0D81, 2, UNICODE_NAAM },
+    { 0x0D85, 17, UNICODE_NAAM_BEGIN }, { 0x0D9A, 23, UNICODE_NAAM_BEGIN }, { 0x0DB3, 8, UNICODE_NAAM_BEGIN },
+    { 0x0DBD, 0, UNICODE_NAAM_BEGIN }, { 0x0DC0, 6, UNICODE_NAAM_BEGIN }, { 0x0DCA, 0, UNICODE_NAAM },
+    { 0x0DCF, 5, UNICODE_NAAM }, { 0x0DD6, 0, UNICODE_NAAM }, { 0x0DD8, 7, UNICODE_NAAM },
+    { 0x0DE6, 9, UNICODE_NAAM }, { 0x0DF2, 1, UNICODE_NAAM }, { 0x0E01, 47, UNICODE_NAAM_BEGIN },
+    { 0x0E31, 0, UNICODE_NAAM }, { 0x0E32, 0, UNICODE_NAAM_BEGIN }, { 0x0E33, 7, UNICODE_NAAM },
+    { 0x0E40, 6, UNICODE_NAAM_BEGIN }, { 0x0E47, 7, UNICODE_NAAM }, { 0x0E50, 9, UNICODE_NAAM },
+    { 0x0E81, 1, UNICODE_NAAM_BEGIN }, { 0x0E84, 0, UNICODE_NAAM_BEGIN }, { 0x0E86, 4, UNICODE_NAAM_BEGIN },
+    { 0x0E8C, 23, UNICODE_NAAM_BEGIN }, { 0x0EA5, 0, UNICODE_NAAM_BEGIN }, { 0x0EA7, 9, UNICODE_NAAM_BEGIN },
+    { 0x0EB1, 0, UNICODE_NAAM }, { 0x0EB2, 0, UNICODE_NAAM_BEGIN }, { 0x0EB3, 9, UNICODE_NAAM },
+    { 0x0EBD, 0, UNICODE_NAAM_BEGIN }, { 0x0EC0, 4, UNICODE_NAAM_BEGIN }, { 0x0EC6, 0, UNICODE_NAAM_BEGIN },
+    { 0x0EC8, 5, UNICODE_NAAM }, { 0x0ED0, 9, UNICODE_NAAM }, { 0x0EDC, 3, UNICODE_NAAM_BEGIN },
+    { 0x0F00, 0, UNICODE_NAAM_BEGIN }, { 0x0F18, 1, UNICODE_NAAM }, { 0x0F20, 9, UNICODE_NAAM },
+    { 0x0F35, 0, UNICODE_NAAM }, { 0x0F37, 0, UNICODE_NAAM }, { 0x0F39, 0, UNICODE_NAAM },
+    { 0x0F3E, 1, UNICODE_NAAM }, { 0x0F40, 7, UNICODE_NAAM_BEGIN }, { 0x0F49, 35, UNICODE_NAAM_BEGIN },
+    { 0x0F71, 19, UNICODE_NAAM }, { 0x0F86, 1, UNICODE_NAAM }, { 0x0F88, 4, UNICODE_NAAM_BEGIN },
+    { 0x0F8D, 10, UNICODE_NAAM }, { 0x0F99, 35, UNICODE_NAAM }, { 0x0FC6, 0, UNICODE_NAAM },
+    { 0x1000, 42, UNICODE_NAAM_BEGIN }, { 0x102B, 19, UNICODE_NAAM }, { 0x103F, 0, UNICODE_NAAM_BEGIN },
+    { 0x1040, 9, UNICODE_NAAM }, { 0x1050, 5, UNICODE_NAAM_BEGIN }, { 0x1056, 3, UNICODE_NAAM },
+    { 0x105A, 3, UNICODE_NAAM_BEGIN }, { 0x105E, 2, UNICODE_NAAM }, { 0x1061, 0, UNICODE_NAAM_BEGIN },
+    { 0x1062, 2, UNICODE_NAAM }, { 0x1065, 1, UNICODE_NAAM_BEGIN }, { 0x1067, 6, UNICODE_NAAM },
+    { 0x106E, 2, UNICODE_NAAM_BEGIN }, { 0x1071, 3, UNICODE_NAAM }, { 0x1075, 12, UNICODE_NAAM_BEGIN },
+    { 0x1082, 11, UNICODE_NAAM }, { 0x108E, 0, UNICODE_NAAM_BEGIN }, { 0x108F, 14, UNICODE_NAAM },
+    { 0x10A0, 37, UNICODE_NAAM_BEGIN }, { 0x10C7, 0, UNICODE_NAAM_BEGIN }, { 0x10CD, 0, UNICODE_NAAM_BEGIN },
+    { 0x10D0, 42, UNICODE_NAAM_BEGIN }, { 0x10FC, 332, UNICODE_NAAM_BEGIN }, { 0x124A, 3, UNICODE_NAAM_BEGIN },
+    { 0x1250, 6, UNICODE_NAAM_BEGIN }, { 0x1258, 0, UNICODE_NAAM_BEGIN }, { 0x125A, 3, UNICODE_NAAM_BEGIN },
+    { 0x1260, 40, UNICODE_NAAM_BEGIN }, { 0x128A, 3, UNICODE_NAAM_BEGIN }, { 0x1290, 32, UNICODE_NAAM_BEGIN },
+    { 0x12B2, 3, UNICODE_NAAM_BEGIN }, { 0x12B8, 6, UNICODE_NAAM_BEGIN }, { 0x12C0, 0, UNICODE_NAAM_BEGIN },
+    { 0x12C2, 3, UNICODE_NAAM_BEGIN }, { 0x12C8, 14, UNICODE_NAAM_BEGIN }, { 0x12D8, 56, UNICODE_NAAM_BEGIN },
+    { 0x1312, 3, UNICODE_NAAM_BEGIN }, { 0x1318, 66, UNICODE_NAAM_BEGIN }, { 0x135D, 2, UNICODE_NAAM },
+    { 0x1369, 8, UNICODE_NAAM }, { 0x1380, 15, UNICODE_NAAM_BEGIN }, { 0x13A0, 85, UNICODE_NAAM_BEGIN },
+    { 0x13F8, 5, UNICODE_NAAM_BEGIN }, { 0x1401, 619, UNICODE_NAAM_BEGIN }, { 0x166F, 16, UNICODE_NAAM_BEGIN },
+    { 0x1681, 25, UNICODE_NAAM_BEGIN }, { 0x16A0, 74, UNICODE_NAAM_BEGIN }, { 0x16EE, 10, UNICODE_NAAM_BEGIN },
+    { 0x1700, 17, UNICODE_NAAM_BEGIN }, { 0x1712, 3, UNICODE_NAAM }, { 0x171F, 18, UNICODE_NAAM_BEGIN },
+    { 0x1732, 2, UNICODE_NAAM }, { 0x1740, 17, UNICODE_NAAM_BEGIN }, { 0x1752, 1, UNICODE_NAAM },
+    { 0x1760, 12, UNICODE_NAAM_BEGIN }, { 0x176E, 2, UNICODE_NAAM_BEGIN }, { 0x1772, 1, UNICODE_NAAM },
+    { 0x1780, 51, UNICODE_NAAM_BEGIN }, { 0x17B4, 31, UNICODE_NAAM }, { 0x17D7, 0, UNICODE_NAAM_BEGIN },
+    { 0x17DC, 0, UNICODE_NAAM_BEGIN }, { 0x17DD, 0, UNICODE_NAAM }, { 0x17E0, 9, UNICODE_NAAM },
+    { 0x180B, 2, UNICODE_NAAM }, { 0x180F, 10, UNICODE_NAAM }, { 0x1820, 88, UNICODE_NAAM_BEGIN },
+    { 0x1880, 40, UNICODE_NAAM_BEGIN }, { 0x18A9, 0, UNICODE_NAAM }, { 0x18AA, 0, UNICODE_NAAM_BEGIN },
+    { 0x18B0, 69, UNICODE_NAAM_BEGIN }, { 0x1900, 30, UNICODE_NAAM_BEGIN }, { 0x1920, 11, UNICODE_NAAM },
+    { 0x1930, 11, UNICODE_NAAM }, { 0x1946, 9, UNICODE_NAAM }, { 0x1950, 29, UNICODE_NAAM_BEGIN },
+    { 0x1970, 4, UNICODE_NAAM_BEGIN }, { 0x1980, 43, UNICODE_NAAM_BEGIN }, { 0x19B0, 25, UNICODE_NAAM_BEGIN },
+    { 0x19D0, 10, UNICODE_NAAM }, { 0x1A00, 22, UNICODE_NAAM_BEGIN }, { 0x1A17, 4, UNICODE_NAAM },
+    { 0x1A20, 52, UNICODE_NAAM_BEGIN }, { 0x1A55, 9, UNICODE_NAAM }, { 0x1A60, 28, UNICODE_NAAM },
+    { 0x1A7F, 10, UNICODE_NAAM }, { 0x1A90, 9, UNICODE_NAAM }, { 0x1AA7, 0, UNICODE_NAAM_BEGIN },
+    { 0x1AB0, 13, UNICODE_NAAM }, { 0x1ABF, 15, UNICODE_NAAM }, { 0x1B00, 4, UNICODE_NAAM },
+    { 0x1B05, 46, UNICODE_NAAM_BEGIN }, { 0x1B34, 16, UNICODE_NAAM }, { 0x1B45, 7, UNICODE_NAAM_BEGIN },
+    { 0x1B50, 9, UNICODE_NAAM }, { 0x1B6B, 8, UNICODE_NAAM }, { 0x1B80, 2, UNICODE_NAAM },
+    { 0x1B83, 29, UNICODE_NAAM_BEGIN }, { 0x1BA1, 12, UNICODE_NAAM }, { 0x1BAE, 1, UNICODE_NAAM_BEGIN },
+    { 0x1BB0, 9, UNICODE_NAAM }, { 0x1BBA, 43, UNICODE_NAAM_BEGIN }, { 0x1BE6, 13, UNICODE_NAAM },
+    { 0x1C00, 35, UNICODE_NAAM_BEGIN }, { 0x1C24, 19, UNICODE_NAAM }, { 0x1C40, 9, UNICODE_NAAM },
+    { 0x1C4D, 2, UNICODE_NAAM_BEGIN }, { 0x1C50, 9, UNICODE_NAAM }, { 0x1C5A, 35, UNICODE_NAAM_BEGIN },
+    { 0x1C80, 8, UNICODE_NAAM_BEGIN }, { 0x1C90, 42, UNICODE_NAAM_BEGIN }, { 0x1CBD, 2, UNICODE_NAAM_BEGIN },
+    { 0x1CD0, 2, UNICODE_NAAM }, { 0x1CD4, 20, UNICODE_NAAM }, { 0x1CE9, 3, UNICODE_NAAM_BEGIN },
+    { 0x1CED, 0, UNICODE_NAAM }, { 0x1CEE, 5, UNICODE_NAAM_BEGIN }, { 0x1CF4, 0, UNICODE_NAAM },
+    { 0x1CF5, 1, UNICODE_NAAM_BEGIN }, { 0x1CF7, 2, UNICODE_NAAM }, { 0x1CFA, 0, UNICODE_NAAM_BEGIN },
+    { 0x1D00, 191, UNICODE_NAAM_BEGIN }, { 0x1DC0, 63, UNICODE_NAAM }, { 0x1E00, 277, UNICODE_NAAM_BEGIN },
+    { 0x1F18, 5, UNICODE_NAAM_BEGIN }, { 0x1F20, 37, UNICODE_NAAM_BEGIN }, { 0x1F48, 5, UNICODE_NAAM_BEGIN },
+    { 0x1F50, 7, UNICODE_NAAM_BEGIN }, { 0x1F59, 0, UNICODE_NAAM_BEGIN }, { 0x1F5B, 0, UNICODE_NAAM_BEGIN },
+    { 0x1F5D, 0, UNICODE_NAAM_BEGIN }, { 0x1F5F, 30, UNICODE_NAAM_BEGIN }, { 0x1F80, 52, UNICODE_NAAM_BEGIN },
+    { 0x1FB6, 6, UNICODE_NAAM_BEGIN }, { 0x1FBE, 0, UNICODE_NAAM_BEGIN }, { 0x1FC2, 2, UNICODE_NAAM_BEGIN },
+    { 0x1FC6, 6, UNICODE_NAAM_BEGIN }, { 0x1FD0, 3, UNICODE_NAAM_BEGIN }, { 0x1FD6, 5, UNICODE_NAAM_BEGIN },
+    { 0x1FE0, 12, UNICODE_NAAM_BEGIN }, { 0x1FF2, 2, UNICODE_NAAM_BEGIN }, { 0x1FF6, 6, UNICODE_NAAM_BEGIN },
+    { 0x203F, 1, UNICODE_NAAM }, { 0x2054, 0, UNICODE_NAAM }, { 0x2071, 0, UNICODE_NAAM_BEGIN },
+    { 0x207F, 0, UNICODE_NAAM_BEGIN }, { 0x2090, 12, UNICODE_NAAM_BEGIN }, { 0x20D0, 12, UNICODE_NAAM },
+    { 0x20E1, 0, UNICODE_NAAM }, { 0x20E5, 11, UNICODE_NAAM }, { 0x2102, 0, UNICODE_NAAM_BEGIN },
+    { 0x2107, 0, UNICODE_NAAM_BEGIN }, { 0x210A, 9, UNICODE_NAAM_BEGIN }, { 0x2115, 0, UNICODE_NAAM_BEGIN },
+    { 0x2118, 5, UNICODE_NAAM_BEGIN }, { 0x2124, 0, UNICODE_NAAM_BEGIN }, { 0x2126, 0, UNICODE_NAAM_BEGIN },
+    { 0x2128, 0, UNICODE_NAAM_BEGIN }, { 0x212A, 15, UNICODE_NAAM_BEGIN }, { 0x213C, 3, UNICODE_NAAM_BEGIN },
+    { 0x2145, 4, UNICODE_NAAM_BEGIN }, { 0x214E, 0, UNICODE_NAAM_BEGIN }, { 0x2160, 40, UNICODE_NAAM_BEGIN },
+    { 0x2C00, 228, UNICODE_NAAM_BEGIN }, { 0x2CEB, 3, UNICODE_NAAM_BEGIN }, { 0x2CEF, 2, UNICODE_NAAM },
+    { 0x2CF2, 1, UNICODE_NAAM_BEGIN }, { 0x2D00, 37, UNICODE_NAAM_BEGIN }, { 0x2D27, 0, UNICODE_NAAM_BEGIN },
+    { 0x2D2D, 0, UNICODE_NAAM_BEGIN }, { 0x2D30, 55, UNICODE_NAAM_BEGIN }, { 0x2D6F, 0, UNICODE_NAAM_BEGIN },
+    { 0x2D7F, 0, UNICODE_NAAM }, { 0x2D80, 22, UNICODE_NAAM_BEGIN }, { 0x2DA0, 6, UNICODE_NAAM_BEGIN },
+    { 0x2DA8, 6, UNICODE_NAAM_BEGIN }, { 0x2DB0, 6, UNICODE_NAAM_BEGIN }, { 0x2DB8, 6, UNICODE_NAAM_BEGIN },
+    { 0x2DC0, 6, UNICODE_NAAM_BEGIN }, { 0x2DC8, 6, UNICODE_NAAM_BEGIN }, { 0x2DD0, 6, UNICODE_NAAM_BEGIN },
+    { 0x2DD8, 6, UNICODE_NAAM_BEGIN }, { 0x2DE0, 31, UNICODE_NAAM }, { 0x3005, 2, UNICODE_NAAM_BEGIN },
+    { 0x3021, 8, UNICODE_NAAM_BEGIN }, { 0x302A, 5, UNICODE_NAAM }, { 0x3031, 4, UNICODE_NAAM_BEGIN },
+    { 0x3038, 4, UNICODE_NAAM_BEGIN }, { 0x3041, 85, UNICODE_NAAM_BEGIN }, { 0x3099, 1, UNICODE_NAAM },
+    { 0x309D, 2, UNICODE_NAAM_BEGIN }, { 0x30A1, 89, UNICODE_NAAM_BEGIN }, { 0x30FC, 3, UNICODE_NAAM_BEGIN },
+    { 0x3105, 42, UNICODE_NAAM_BEGIN }, { 0x3131, 93, UNICODE_NAAM_BEGIN }, { 0x31A0, 31, UNICODE_NAAM_BEGIN },
+    { 0x31F0, 15, UNICODE_NAAM_BEGIN }, { 0x3400, 6591, UNICODE_NAAM_BEGIN }, { 0x4E00, 22156, UNICODE_NAAM_BEGIN },
+    { 0xA4D0, 45, UNICODE_NAAM_BEGIN }, { 0xA500, 268, UNICODE_NAAM_BEGIN }, { 0xA610, 15, UNICODE_NAAM_BEGIN },
+    { 0xA620, 9, UNICODE_NAAM }, { 0xA62A, 1, UNICODE_NAAM_BEGIN }, { 0xA640, 46, UNICODE_NAAM_BEGIN },
+    { 0xA66F, 0, UNICODE_NAAM }, { 0xA674, 9, UNICODE_NAAM }, { 0xA67F, 30, UNICODE_NAAM_BEGIN },
+    { 0xA69E, 1, UNICODE_NAAM }, { 0xA6A0, 79, UNICODE_NAAM_BEGIN }, { 0xA6F0, 1, UNICODE_NAAM },
+    { 0xA717, 8, UNICODE_NAAM_BEGIN }, { 0xA722, 102, UNICODE_NAAM_BEGIN }, { 0xA78B, 63, UNICODE_NAAM_BEGIN },
+    { 0xA7D0, 1, UNICODE_NAAM_BEGIN }, { 0xA7D3, 0, UNICODE_NAAM_BEGIN }, { 0xA7D5, 4, UNICODE_NAAM_BEGIN },
+    { 0xA7F2, 15, UNICODE_NAAM_BEGIN }, { 0xA802, 0, UNICODE_NAAM }, { 0xA803, 2, UNICODE_NAAM_BEGIN },
+    { 0xA806, 0, UNICODE_NAAM }, { 0xA807, 3, UNICODE_NAAM_BEGIN }, { 0xA80B, 0, UNICODE_NAAM },
+    { 0xA80C, 22, UNICODE_NAAM_BEGIN }, { 0xA823, 4, UNICODE_NAAM }, { 0xA82C, 0, UNICODE_NAAM },
+    { 0xA840, 51, UNICODE_NAAM_BEGIN }, { 0xA880, 1, UNICODE_NAAM }, { 0xA882, 49, UNICODE_NAAM_BEGIN },
+    { 0xA8B4, 17, UNICODE_NAAM }, { 0xA8D0, 9, UNICODE_NAAM }, { 0xA8E0, 17, UNICODE_NAAM },
+    { 0xA8F2, 5, UNICODE_NAAM_BEGIN }, { 0xA8FB, 0, UNICODE_NAAM_BEGIN }, { 0xA8FD, 1, UNICODE_NAAM_BEGIN },
+    { 0xA8FF, 10, UNICODE_NAAM }, { 0xA90A, 27, UNICODE_NAAM_BEGIN }, { 0xA926, 7, UNICODE_NAAM },
+    { 0xA930, 22, UNICODE_NAAM_BEGIN }, { 0xA947, 12, UNICODE_NAAM }, { 0xA960, 28, UNICODE_NAAM_BEGIN },
+    { 0xA980, 3, UNICODE_NAAM }, { 0xA984, 46, UNICODE_NAAM_BEGIN }, { 0xA9B3, 13, UNICODE_NAAM },
+    { 0xA9CF, 0, UNICODE_NAAM_BEGIN }, { 0xA9D0, 9, UNICODE_NAAM }, { 0xA9E0, 4, UNICODE_NAAM_BEGIN },
+    { 0xA9E5, 0, UNICODE_NAAM }, { 0xA9E6, 9, UNICODE_NAAM_BEGIN }, { 0xA9F0, 9, UNICODE_NAAM },
+    { 0xA9FA, 4, UNICODE_NAAM_BEGIN }, { 0xAA00, 40, UNICODE_NAAM_BEGIN }, { 0xAA29, 13, UNICODE_NAAM },
+    { 0xAA40, 2, UNICODE_NAAM_BEGIN }, { 0xAA43, 0, UNICODE_NAAM }, { 0xAA44, 7, UNICODE_NAAM_BEGIN },
+    { 0xAA4C, 1, UNICODE_NAAM }, { 0xAA50, 9, UNICODE_NAAM }, { 0xAA60, 22, UNICODE_NAAM_BEGIN },
+    { 0xAA7A, 0, UNICODE_NAAM_BEGIN }, { 0xAA7B, 2, UNICODE_NAAM }, { 0xAA7E, 49, UNICODE_NAAM_BEGIN },
+    { 0xAAB0, 0, UNICODE_NAAM }, { 0xAAB1, 0, UNICODE_NAAM_BEGIN }, { 0xAAB2, 2, UNICODE_NAAM },
+    { 0xAAB5, 1, UNICODE_NAAM_BEGIN }, { 0xAAB7, 1, UNICODE_NAAM }, { 0xAAB9, 4, UNICODE_NAAM_BEGIN },
+    { 0xAABE, 1, UNICODE_NAAM }, { 0xAAC0, 0, UNICODE_NAAM_BEGIN }, { 0xAAC1, 0, UNICODE_NAAM },
+    { 0xAAC2, 0, UNICODE_NAAM_BEGIN }, { 0xAADB, 2, UNICODE_NAAM_BEGIN }, { 0xAAE0, 10, UNICODE_NAAM_BEGIN },
+    { 0xAAEB, 4, UNICODE_NAAM }, { 0xAAF2, 2, UNICODE_NAAM_BEGIN }, { 0xAAF5, 1, UNICODE_NAAM },
+    { 0xAB01, 5, UNICODE_NAAM_BEGIN }, { 0xAB09, 5, UNICODE_NAAM_BEGIN }, { 0xAB11, 5, UNICODE_NAAM_BEGIN },
+    { 0xAB20, 6, UNICODE_NAAM_BEGIN }, { 0xAB28, 6, UNICODE_NAAM_BEGIN }, { 0xAB30, 42, UNICODE_NAAM_BEGIN },
+    { 0xAB5C, 13, UNICODE_NAAM_BEGIN }, { 0xAB70, 114, UNICODE_NAAM_BEGIN }, { 0xABE3, 7, UNICODE_NAAM },
+    { 0xABEC, 1, UNICODE_NAAM }, { 0xABF0, 9, UNICODE_NAAM }, { 0xAC00, 11171, UNICODE_NAAM_BEGIN },
+    { 0xD7B0, 22, UNICODE_NAAM_BEGIN }, { 0xD7CB, 48, UNICODE_NAAM_BEGIN }, { 0xF900, 365, UNICODE_NAAM_BEGIN },
+    { 0xFA70, 105, UNICODE_NAAM_BEGIN }, { 0xFB00, 6, UNICODE_NAAM_BEGIN }, { 0xFB13, 4, UNICODE_NAAM_BEGIN },
+    { 0xFB1D, 0, UNICODE_NAAM_BEGIN }, { 0xFB1E, 0, UNICODE_NAAM }, { 0xFB1F, 9, UNICODE_NAAM_BEGIN },
+    { 0xFB2A, 12, UNICODE_NAAM_BEGIN }, { 0xFB38, 4, UNICODE_NAAM_BEGIN }, { 0xFB3E, 0, UNICODE_NAAM_BEGIN },
+    { 0xFB40, 1, UNICODE_NAAM_BEGIN }, { 0xFB43, 1, UNICODE_NAAM_BEGIN }, { 0xFB46, 107, UNICODE_NAAM_BEGIN },
+    { 0xFBD3, 138, UNICODE_NAAM_BEGIN }, { 0xFC64, 217, UNICODE_NAAM_BEGIN }, { 0xFD50, 63, UNICODE_NAAM_BEGIN },
+    { 0xFD92, 53, UNICODE_NAAM_BEGIN }, { 0xFDF0, 9, UNICODE_NAAM_BEGIN }, { 0xFE00, 15, UNICODE_NAAM },
+    { 0xFE20, 15, UNICODE_NAAM }, { 0xFE33, 1, UNICODE_NAAM }, { 0xFE4D, 2, UNICODE_NAAM },
+    { 0xFE71, 0, UNICODE_NAAM_BEGIN }, { 0xFE73, 0, UNICODE_NAAM_BEGIN }, { 0xFE77, 0, UNICODE_NAAM_BEGIN },
+    { 0xFE79, 0, UNICODE_NAAM_BEGIN }, { 0xFE7B, 0, UNICODE_NAAM_BEGIN }, { 0xFE7D, 0, UNICODE_NAAM_BEGIN },
+    { 0xFE7F, 125, UNICODE_NAAM_BEGIN }, { 0xFF10, 9, UNICODE_NAAM }, { 0xFF21, 25, UNICODE_NAAM_BEGIN },
+    { 0xFF3F, 0, UNICODE_NAAM }, { 0xFF41, 25, UNICODE_NAAM_BEGIN }, { 0xFF66, 55, UNICODE_NAAM_BEGIN },
+    { 0xFF9E, 1, UNICODE_NAAM }, { 0xFFA0, 30, UNICODE_NAAM_BEGIN }, { 0xFFC2, 5, UNICODE_NAAM_BEGIN },
+    { 0xFFCA, 5, UNICODE_NAAM_BEGIN }, { 0xFFD2, 5, UNICODE_NAAM_BEGIN }, { 0xFFDA, 2, UNICODE_NAAM_BEGIN },
+    { 0x10000, 11, UNICODE_NAAM_BEGIN }, { 0x1000D, 25, UNICODE_NAAM_BEGIN }, { 0x10028, 18, UNICODE_NAAM_BEGIN },
+    { 0x1003C, 1, UNICODE_NAAM_BEGIN }, { 0x1003F, 14, UNICODE_NAAM_BEGIN }, { 0x10050, 13, UNICODE_NAAM_BEGIN },
+    { 0x10080, 122, UNICODE_NAAM_BEGIN }, { 0x10140, 52, UNICODE_NAAM_BEGIN }, { 0x101FD, 0, UNICODE_NAAM },
+    { 0x10280, 28, UNICODE_NAAM_BEGIN }, { 0x102A0, 48, UNICODE_NAAM_BEGIN }, { 0x102E0, 0, UNICODE_NAAM },
+    { 0x10300, 31, UNICODE_NAAM_BEGIN }, { 0x1032D, 29, UNICODE_NAAM_BEGIN }, { 0x10350, 37, UNICODE_NAAM_BEGIN },
+    { 0x10376, 4, UNICODE_NAAM }, { 0x10380, 29, UNICODE_NAAM_BEGIN }, { 0x103A0, 35, UNICODE_NAAM_BEGIN },
+    { 0x103C8, 7, UNICODE_NAAM_BEGIN }, { 0x103D1, 4, UNICODE_NAAM_BEGIN }, { 0x10400, 157, UNICODE_NAAM_BEGIN },
+    { 0x104A0, 9, UNICODE_NAAM }, { 0x104B0, 35, UNICODE_NAAM_BEGIN }, { 0x104D8, 35, UNICODE_NAAM_BEGIN },
+    { 0x10500, 39, UNICODE_NAAM_BEGIN }, { 0x10530, 51, UNICODE_NAAM_BEGIN }, { 0x10570, 10, UNICODE_NAAM_BEGIN },
+    { 0x1057C, 14, UNICODE_NAAM_BEGIN }, { 0x1058C, 6, UNICODE_NAAM_BEGIN }, { 0x10594, 1, UNICODE_NAAM_BEGIN },
+    { 0x10597, 10, UNICODE_NAAM_BEGIN }, { 0x105A3, 14, UNICODE_NAAM_BEGIN }, { 0x105B3, 6, UNICODE_NAAM_BEGIN },
+    { 0x105BB, 1, UNICODE_NAAM_BEGIN }, { 0x10600, 310, UNICODE_NAAM_BEGIN }, { 0x10740, 21, UNICODE_NAAM_BEGIN },
+    { 0x10760, 7, UNICODE_NAAM_BEGIN }, { 0x10780, 5, UNICODE_NAAM_BEGIN }, { 0x10787, 41, UNICODE_NAAM_BEGIN },
+    { 0x107B2, 8, UNICODE_NAAM_BEGIN }, { 0x10800, 5, UNICODE_NAAM_BEGIN }, { 0x10808, 0, UNICODE_NAAM_BEGIN },
+    { 0x1080A, 43, UNICODE_NAAM_BEGIN }, { 0x10837, 1, UNICODE_NAAM_BEGIN }, { 0x1083C, 0, UNICODE_NAAM_BEGIN },
+    { 0x1083F, 22, UNICODE_NAAM_BEGIN }, { 0x10860, 22, UNICODE_NAAM_BEGIN }, { 0x10880, 30, UNICODE_NAAM_BEGIN },
+    { 0x108E0, 18, UNICODE_NAAM_BEGIN }, { 0x108F4, 1, UNICODE_NAAM_BEGIN }, { 0x10900, 21, UNICODE_NAAM_BEGIN },
+    { 0x10920, 25, UNICODE_NAAM_BEGIN }, { 0x10980, 55, UNICODE_NAAM_BEGIN }, { 0x109BE, 1, UNICODE_NAAM_BEGIN },
+    { 0x10A00, 0, UNICODE_NAAM_BEGIN }, { 0x10A01, 2, UNICODE_NAAM }, { 0x10A05, 1, UNICODE_NAAM },
+    { 0x10A0C, 3, UNICODE_NAAM }, { 0x10A10, 3, UNICODE_NAAM_BEGIN }, { 0x10A15, 2, UNICODE_NAAM_BEGIN },
+    { 0x10A19, 28, UNICODE_NAAM_BEGIN }, { 0x10A38, 2, UNICODE_NAAM }, { 0x10A3F, 0, UNICODE_NAAM },
+    { 0x10A60, 28, UNICODE_NAAM_BEGIN }, { 0x10A80, 28, UNICODE_NAAM_BEGIN }, { 0x10AC0, 7, UNICODE_NAAM_BEGIN },
+    { 0x10AC9, 27, UNICODE_NAAM_BEGIN }, { 0x10AE5, 1, UNICODE_NAAM }, { 0x10B00, 53, UNICODE_NAAM_BEGIN },
+    { 0x10B40, 21, UNICODE_NAAM_BEGIN }, { 0x10B60, 18, UNICODE_NAAM_BEGIN }, { 0x10B80, 17, UNICODE_NAAM_BEGIN },
+    { 0x10C00, 72, UNICODE_NAAM_BEGIN }, { 0x10C80, 50, UNICODE_NAAM_BEGIN }, { 0x10CC0, 50, UNICODE_NAAM_BEGIN },
+    { 0x10D00, 35, UNICODE_NAAM_BEGIN }, { 0x10D24, 3, UNICODE_NAAM }, { 0x10D30, 9, UNICODE_NAAM },
+    { 0x10E80, 41, UNICODE_NAAM_BEGIN }, { 0x10EAB, 1, UNICODE_NAAM }, { 0x10EB0, 1, UNICODE_NAAM_BEGIN },
+    { 0x10F00, 28, UNICODE_NAAM_BEGIN }, { 0x10F27, 0, UNICODE_NAAM_BEGIN }, { 0x10F30, 21, UNICODE_NAAM_BEGIN },
+    { 0x10F46, 10, UNICODE_NAAM }, { 0x10F70, 17, UNICODE_NAAM_BEGIN }, { 0x10F82, 3, UNICODE_NAAM },
+    { 0x10FB0, 20, UNICODE_NAAM_BEGIN }, { 0x10FE0, 22, UNICODE_NAAM_BEGIN }, { 0x11000, 2, UNICODE_NAAM },
+    { 0x11003, 52, UNICODE_NAAM_BEGIN }, { 0x11038, 14, UNICODE_NAAM }, { 0x11066, 10, UNICODE_NAAM },
+    { 0x11071, 1, UNICODE_NAAM_BEGIN }, { 0x11073, 1, UNICODE_NAAM }, { 0x11075, 0, UNICODE_NAAM_BEGIN },
+    { 0x1107F, 3, UNICODE_NAAM }, { 0x11083, 44, UNICODE_NAAM_BEGIN }, { 0x110B0, 10, UNICODE_NAAM },
+    { 0x110C2, 0, UNICODE_NAAM }, { 0x110D0, 24, UNICODE_NAAM_BEGIN }, { 0x110F0, 9, UNICODE_NAAM },
+    { 0x11100, 2, UNICODE_NAAM }, { 0x11103, 35, UNICODE_NAAM_BEGIN }, { 0x11127, 13, UNICODE_NAAM },
+    { 0x11136, 9, UNICODE_NAAM }, { 0x11144, 0, UNICODE_NAAM_BEGIN }, { 0x11145, 1, UNICODE_NAAM },
+    { 0x11147, 0, UNICODE_NAAM_BEGIN }, { 0x11150, 34, UNICODE_NAAM_BEGIN }, { 0x11173, 0, UNICODE_NAAM },
+    { 0x11176, 0, UNICODE_NAAM_BEGIN }, { 0x11180, 2, UNICODE_NAAM }, { 0x11183, 47, UNICODE_NAAM_BEGIN },
+    { 0x111B3, 13, UNICODE_NAAM }, { 0x111C1, 3, UNICODE_NAAM_BEGIN }, { 0x111C9, 3, UNICODE_NAAM },
+    { 0x111CE, 11, UNICODE_NAAM }, { 0x111DA, 0, UNICODE_NAAM_BEGIN }, { 0x111DC, 0, UNICODE_NAAM_BEGIN },
+    { 0x11200, 17, UNICODE_NAAM_BEGIN }, { 0x11213, 24, UNICODE_NAAM_BEGIN }, { 0x1122C, 11, UNICODE_NAAM },
+    { 0x1123E, 0, UNICODE_NAAM }, { 0x11280, 6, UNICODE_NAAM_BEGIN }, { 0x11288, 0, UNICODE_NAAM_BEGIN },
+    { 0x1128A, 3, UNICODE_NAAM_BEGIN }, { 0x1128F, 14, UNICODE_NAAM_BEGIN }, { 0x1129F, 9, UNICODE_NAAM_BEGIN },
+    { 0x112B0, 46, UNICODE_NAAM_BEGIN }, { 0x112DF, 11, UNICODE_NAAM }, { 0x112F0, 9, UNICODE_NAAM },
+    { 0x11300, 3, UNICODE_NAAM }, { 0x11305, 7, UNICODE_NAAM_BEGIN }, { 0x1130F, 1, UNICODE_NAAM_BEGIN },
+    { 0x11313, 21, UNICODE_NAAM_BEGIN }, { 0x1132A, 6, UNICODE_NAAM_BEGIN }, { 0x11332, 1, UNICODE_NAAM_BEGIN },
+    { 0x11335, 4, UNICODE_NAAM_BEGIN }, { 0x1133B, 1, UNICODE_NAAM }, { 0x1133D, 0, UNICODE_NAAM_BEGIN },
+    { 0x1133E, 6, UNICODE_NAAM }, { 0x11347, 1, UNICODE_NAAM }, { 0x1134B, 2, UNICODE_NAAM },
+    { 0x11350, 0, UNICODE_NAAM_BEGIN }, { 0x11357, 0, UNICODE_NAAM }, { 0x1135D, 4, UNICODE_NAAM_BEGIN },
+    { 0x11362, 1, UNICODE_NAAM }, { 0x11366, 6, UNICODE_NAAM }, { 0x11370, 4, UNICODE_NAAM },
+    { 0x11400, 52, UNICODE_NAAM_BEGIN }, { 0x11435, 17, UNICODE_NAAM }, { 0x11447, 3, UNICODE_NAAM_BEGIN },
+    { 0x11450, 9, UNICODE_NAAM }, { 0x1145E, 0, UNICODE_NAAM }, { 0x1145F, 2, UNICODE_NAAM_BEGIN },
+    { 0x11480, 47, UNICODE_NAAM_BEGIN }, { 0x114B0, 19, UNICODE_NAAM }, { 0x114C4, 1, UNICODE_NAAM_BEGIN },
+    { 0x114C7, 0, UNICODE_NAAM_BEGIN }, { 0x114D0, 9, UNICODE_NAAM }, { 0x11580, 46, UNICODE_NAAM_BEGIN },
+    { 0x115AF, 6, UNICODE_NAAM }, { 0x115B8, 8, UNICODE_NAAM }, { 0x115D8, 3, UNICODE_NAAM_BEGIN },
+    { 0x115DC, 1, UNICODE_NAAM }, { 0x11600, 47, UNICODE_NAAM_BEGIN }, { 0x11630, 16, UNICODE_NAAM },
+    { 0x11644, 0, UNICODE_NAAM_BEGIN }, { 0x11650, 9, UNICODE_NAAM }, { 0x11680, 42, UNICODE_NAAM_BEGIN },
+    { 0x116AB, 12, UNICODE_NAAM }, { 0x116B8, 0, UNICODE_NAAM_BEGIN }, { 0x116C0, 9, UNICODE_NAAM },
+    { 0x11700, 26, UNICODE_NAAM_BEGIN }, { 0x1171D, 14, UNICODE_NAAM }, { 0x11730, 9, UNICODE_NAAM },
+    { 0x11740, 6, UNICODE_NAAM_BEGIN }, { 0x11800, 43, UNICODE_NAAM_BEGIN }, { 0x1182C, 14, UNICODE_NAAM },
+    { 0x118A0, 63, UNICODE_NAAM_BEGIN }, { 0x118E0, 9, UNICODE_NAAM }, { 0x118FF, 7, UNICODE_NAAM_BEGIN },
+    { 0x11909, 0, UNICODE_NAAM_BEGIN }, { 0x1190C, 7, UNICODE_NAAM_BEGIN }, { 0x11915, 1, UNICODE_NAAM_BEGIN },
+    { 0x11918, 23, UNICODE_NAAM_BEGIN }, { 0x11930, 5, UNICODE_NAAM }, { 0x11937, 1, UNICODE_NAAM },
+    { 0x1193B, 3, UNICODE_NAAM }, { 0x1193F, 0, UNICODE_NAAM_BEGIN }, { 0x11940, 0, UNICODE_NAAM },
+    { 0x11941, 0, UNICODE_NAAM_BEGIN }, { 0x11942, 1, UNICODE_NAAM }, { 0x11950, 9, UNICODE_NAAM },
+    { 0x119A0, 7, UNICODE_NAAM_BEGIN }, { 0x119AA, 38, UNICODE_NAAM_BEGIN }, { 0x119D1, 6, UNICODE_NAAM },
+    { 0x119DA, 6, UNICODE_NAAM }, { 0x119E1, 0, UNICODE_NAAM_BEGIN }, { 0x119E3, 0, UNICODE_NAAM_BEGIN },
+    { 0x119E4, 0, UNICODE_NAAM }, { 0x11A00, 0, UNICODE_NAAM_BEGIN }, { 0x11A01, 9, UNICODE_NAAM },
+    { 0x11A0B, 39, UNICODE_NAAM_BEGIN }, { 0x11A33, 6, UNICODE_NAAM }, { 0x11A3A, 0, UNICODE_NAAM_BEGIN },
+    { 0x11A3B, 3, UNICODE_NAAM }, { 0x11A47, 0, UNICODE_NAAM }, { 0x11A50, 0, UNICODE_NAAM_BEGIN },
+    { 0x11A51, 10, UNICODE_NAAM }, { 0x11A5C, 45, UNICODE_NAAM_BEGIN }, { 0x11A8A, 15, UNICODE_NAAM },
+    { 0x11A9D, 0, UNICODE_NAAM_BEGIN }, { 0x11AB0, 72, UNICODE_NAAM_BEGIN }, { 0x11C00, 8, UNICODE_NAAM_BEGIN },
+    { 0x11C0A, 36, UNICODE_NAAM_BEGIN }, { 0x11C2F, 7, UNICODE_NAAM }, { 0x11C38, 7, UNICODE_NAAM },
+    { 0x11C40, 0, UNICODE_NAAM_BEGIN }, { 0x11C50, 9, UNICODE_NAAM }, { 0x11C72, 29, UNICODE_NAAM_BEGIN },
+    { 0x11C92, 21, UNICODE_NAAM }, { 0x11CA9, 13, UNICODE_NAAM }, { 0x11D00, 6, UNICODE_NAAM_BEGIN },
+    { 0x11D08, 1, UNICODE_NAAM_BEGIN }, { 0x11D0B, 37, UNICODE_NAAM_BEGIN }, { 0x11D31, 5, UNICODE_NAAM },
+    { 0x11D3A, 0, UNICODE_NAAM }, { 0x11D3C, 1, UNICODE_NAAM }, { 0x11D3F, 6, UNICODE_NAAM },
+    { 0x11D46, 0, UNICODE_NAAM_BEGIN }, { 0x11D47, 0, UNICODE_NAAM }, { 0x11D50, 9, UNICODE_NAAM },
+    { 0x11D60, 5, UNICODE_NAAM_BEGIN }, { 0x11D67, 1, UNICODE_NAAM_BEGIN }, { 0x11D6A, 31, UNICODE_NAAM_BEGIN },
+    { 0x11D8A, 4, UNICODE_NAAM }, { 0x11D90, 1, UNICODE_NAAM }, { 0x11D93, 4, UNICODE_NAAM },
+    { 0x11D98, 0, UNICODE_NAAM_BEGIN }, { 0x11DA0, 9, UNICODE_NAAM }, { 0x11EE0, 18, UNICODE_NAAM_BEGIN },
+    { 0x11EF3, 3, UNICODE_NAAM }, { 0x11FB0, 0, UNICODE_NAAM_BEGIN }, { 0x12000, 921, UNICODE_NAAM_BEGIN },
+    { 0x12400, 110, UNICODE_NAAM_BEGIN }, { 0x12480, 195, UNICODE_NAAM_BEGIN }, { 0x12F90, 96, UNICODE_NAAM_BEGIN },
+    { 0x13000, 1070, UNICODE_NAAM_BEGIN }, { 0x14400, 582, UNICODE_NAAM_BEGIN }, { 0x16800, 568, UNICODE_NAAM_BEGIN },
+    { 0x16A40, 30, UNICODE_NAAM_BEGIN }, { 0x16A60, 9, UNICODE_NAAM }, { 0x16A70, 78, UNICODE_NAAM_BEGIN },
+    { 0x16AC0, 9, UNICODE_NAAM }, { 0x16AD0, 29, UNICODE_NAAM_BEGIN }, { 0x16AF0, 4, UNICODE_NAAM },
+    { 0x16B00, 47, UNICODE_NAAM_BEGIN }, { 0x16B30, 6, UNICODE_NAAM }, { 0x16B40, 3, UNICODE_NAAM_BEGIN },
+    { 0x16B50, 9, UNICODE_NAAM }, { 0x16B63, 20, UNICODE_NAAM_BEGIN }, { 0x16B7D, 18, UNICODE_NAAM_BEGIN },
+    { 0x16E40, 63, UNICODE_NAAM_BEGIN }, { 0x16F00, 74, UNICODE_NAAM_BEGIN }, { 0x16F4F, 0, UNICODE_NAAM },
+    { 0x16F50, 0, UNICODE_NAAM_BEGIN }, { 0x16F51, 54, UNICODE_NAAM }, { 0x16F8F, 3, UNICODE_NAAM },
+    { 0x16F93, 12, UNICODE_NAAM_BEGIN }, { 0x16FE0, 1, UNICODE_NAAM_BEGIN }, { 0x16FE3, 0, UNICODE_NAAM_BEGIN },
+    { 0x16FE4, 0, UNICODE_NAAM }, { 0x16FF0, 1, UNICODE_NAAM }, { 0x17000, 6135, UNICODE_NAAM_BEGIN },
+    { 0x18800, 1237, UNICODE_NAAM_BEGIN }, { 0x18D00, 8, UNICODE_NAAM_BEGIN }, { 0x1AFF0, 3, UNICODE_NAAM_BEGIN },
+    { 0x1AFF5, 6, UNICODE_NAAM_BEGIN }, { 0x1AFFD, 1, UNICODE_NAAM_BEGIN }, { 0x1B000, 290, UNICODE_NAAM_BEGIN },
+    { 0x1B150, 2, UNICODE_NAAM_BEGIN }, { 0x1B164, 3, UNICODE_NAAM_BEGIN }, { 0x1B170, 395, UNICODE_NAAM_BEGIN },
+    { 0x1BC00, 106, UNICODE_NAAM_BEGIN }, { 0x1BC70, 12, UNICODE_NAAM_BEGIN }, { 0x1BC80, 8, UNICODE_NAAM_BEGIN },
+    { 0x1BC90, 9, UNICODE_NAAM_BEGIN }, { 0x1BC9D, 1, UNICODE_NAAM }, { 0x1CF00, 45, UNICODE_NAAM },
+    { 0x1CF30, 22, UNICODE_NAAM }, { 0x1D165, 4, UNICODE_NAAM }, { 0x1D16D, 5, UNICODE_NAAM },
+    { 0x1D17B, 7, UNICODE_NAAM }, { 0x1D185, 6, UNICODE_NAAM }, { 0x1D1AA, 3, UNICODE_NAAM },
+    { 0x1D242, 2, UNICODE_NAAM }, { 0x1D400, 84, UNICODE_NAAM_BEGIN }, { 0x1D456, 70, UNICODE_NAAM_BEGIN },
+    { 0x1D49E, 1, UNICODE_NAAM_BEGIN }, { 0x1D4A2, 0, UNICODE_NAAM_BEGIN }, { 0x1D4A5, 1, UNICODE_NAAM_BEGIN },
+    { 0x1D4A9, 3, UNICODE_NAAM_BEGIN }, { 0x1D4AE, 11, UNICODE_NAAM_BEGIN }, { 0x1D4BB, 0, UNICODE_NAAM_BEGIN },
+    { 0x1D4BD, 6, UNICODE_NAAM_BEGIN }, { 0x1D4C5, 64, UNICODE_NAAM_BEGIN }, { 0x1D507, 3, UNICODE_NAAM_BEGIN },
+    { 0x1D50D, 7, UNICODE_NAAM_BEGIN }, { 0x1D516, 6, UNICODE_NAAM_BEGIN }, { 0x1D51E, 27, UNICODE_NAAM_BEGIN },
+    { 0x1D53B, 3, UNICODE_NAAM_BEGIN }, { 0x1D540, 4, UNICODE_NAAM_BEGIN }, { 0x1D546, 0, UNICODE_NAAM_BEGIN },
+    { 0x1D54A, 6, UNICODE_NAAM_BEGIN }, { 0x1D552, 339, UNICODE_NAAM_BEGIN }, { 0x1D6A8, 24, UNICODE_NAAM_BEGIN },
+    { 0x1D6C2, 24, UNICODE_NAAM_BEGIN }, { 0x1D6DC, 30, UNICODE_NAAM_BEGIN }, { 0x1D6FC, 24, UNICODE_NAAM_BEGIN },
+    { 0x1D716, 30, UNICODE_NAAM_BEGIN }, { 0x1D736, 24, UNICODE_NAAM_BEGIN }, { 0x1D750, 30, UNICODE_NAAM_BEGIN },
+    { 0x1D770, 24, UNICODE_NAAM_BEGIN }, { 0x1D78A, 30, UNICODE_NAAM_BEGIN }, { 0x1D7AA, 24, UNICODE_NAAM_BEGIN },
+    { 0x1D7C4, 7, UNICODE_NAAM_BEGIN }, { 0x1D7CE, 49, UNICODE_NAAM }, { 0x1DA00, 54, UNICODE_NAAM },
+    { 0x1DA3B, 49, UNICODE_NAAM }, { 0x1DA75, 0, UNICODE_NAAM }, { 0x1DA84, 0, UNICODE_NAAM },
+    { 0x1DA9B, 4, UNICODE_NAAM }, { 0x1DAA1, 14, UNICODE_NAAM }, { 0x1DF00, 30, UNICODE_NAAM_BEGIN },
+    { 0x1E000, 6, UNICODE_NAAM }, { 0x1E008, 16, UNICODE_NAAM }, { 0x1E01B, 6, UNICODE_NAAM },
+    { 0x1E023, 1, UNICODE_NAAM }, { 0x1E026, 4, UNICODE_NAAM }, { 0x1E100, 44, UNICODE_NAAM_BEGIN },
+    { 0x1E130, 6, UNICODE_NAAM }, { 0x1E137, 6, UNICODE_NAAM_BEGIN }, { 0x1E140, 9, UNICODE_NAAM },
+    { 0x1E14E, 0, UNICODE_NAAM_BEGIN }, { 0x1E290, 29, UNICODE_NAAM_BEGIN }, { 0x1E2AE, 0, UNICODE_NAAM },
+    { 0x1E2C0, 43, UNICODE_NAAM_BEGIN }, { 0x1E2EC, 13, UNICODE_NAAM }, { 0x1E7E0, 6, UNICODE_NAAM_BEGIN },
+    { 0x1E7E8, 3, UNICODE_NAAM_BEGIN }, { 0x1E7ED, 1, UNICODE_NAAM_BEGIN }, { 0x1E7F0, 14, UNICODE_NAAM_BEGIN },
+    { 0x1E800, 196, UNICODE_NAAM_BEGIN }, { 0x1E8D0, 6, UNICODE_NAAM }, { 0x1E900, 67, UNICODE_NAAM_BEGIN },
+    { 0x1E944, 6, UNICODE_NAAM }, { 0x1E94B, 0, UNICODE_NAAM_BEGIN }, { 0x1E950, 9, UNICODE_NAAM },
+    { 0x1EE00, 3, UNICODE_NAAM_BEGIN }, { 0x1EE05, 26, UNICODE_NAAM_BEGIN }, { 0x1EE21, 1, UNICODE_NAAM_BEGIN },
+    { 0x1EE24, 0, UNICODE_NAAM_BEGIN }, { 0x1EE27, 0, UNICODE_NAAM_BEGIN }, { 0x1EE29, 9, UNICODE_NAAM_BEGIN },
+    { 0x1EE34, 3, UNICODE_NAAM_BEGIN }, { 0x1EE39, 0, UNICODE_NAAM_BEGIN }, { 0x1EE3B, 0, UNICODE_NAAM_BEGIN },
+    { 0x1EE42, 0, UNICODE_NAAM_BEGIN }, { 0x1EE47, 0, UNICODE_NAAM_BEGIN }, { 0x1EE49, 0, UNICODE_NAAM_BEGIN },
+    { 0x1EE4B, 0, UNICODE_NAAM_BEGIN }, { 0x1EE4D, 2, UNICODE_NAAM_BEGIN }, { 0x1EE51, 1, UNICODE_NAAM_BEGIN },
+    { 0x1EE54, 0, UNICODE_NAAM_BEGIN }, { 0x1EE57, 0, UNICODE_NAAM_BEGIN }, { 0x1EE59, 0, UNICODE_NAAM_BEGIN },
+    { 0x1EE5B, 0, UNICODE_NAAM_BEGIN }, { 0x1EE5D, 0, UNICODE_NAAM_BEGIN }, { 0x1EE5F, 0, UNICODE_NAAM_BEGIN },
+    { 0x1EE61, 1, UNICODE_NAAM_BEGIN }, { 0x1EE64, 0, UNICODE_NAAM_BEGIN }, { 0x1EE67, 3, UNICODE_NAAM_BEGIN },
+    { 0x1EE6C, 6, UNICODE_NAAM_BEGIN }, { 0x1EE74, 3, UNICODE_NAAM_BEGIN }, { 0x1EE79, 3, UNICODE_NAAM_BEGIN },
+    { 0x1EE7E, 0, UNICODE_NAAM_BEGIN }, { 0x1EE80, 9, UNICODE_NAAM_BEGIN }, { 0x1EE8B, 16, UNICODE_NAAM_BEGIN },
+    { 0x1EEA1, 2, UNICODE_NAAM_BEGIN }, { 0x1EEA5, 4, UNICODE_NAAM_BEGIN }, { 0x1EEAB, 16, UNICODE_NAAM_BEGIN },
+    { 0x1FBF0, 9, UNICODE_NAAM }, { 0x20000, 42719, UNICODE_NAAM_BEGIN }, { 0x2A700, 4152, UNICODE_NAAM_BEGIN },
+    { 0x2B740, 221, UNICODE_NAAM_BEGIN }, { 0x2B820, 5761, UNICODE_NAAM_BEGIN }, { 0x2CEB0, 7472, UNICODE_NAAM_BEGIN },
+    { 0x2F800, 541, UNICODE_NAAM_BEGIN }, { 0x30000, 4938, UNICODE_NAAM_BEGIN }, { 0xE0100, 239, UNICODE_NAAM },
+};
+
+static uint16_t unicode_soort(uint32_t codepunt)
+{
+    size_t laag = 0;
+    size_t hoog = sizeof(unicode_bereiken) / sizeof(unicode_bereiken[0]);
+    while (laag < hoog) {
+        size_t midden = laag + (hoog - laag) / 2;
+        const unicode_bereik *b = &unicode_bereiken[midden];
+        if (codepunt < b->begin) {
+            hoog = midden;
+        } else if (codepunt - b->begin > b->lengte) {
+            laag = midden + 1;
+        } else {
+            return b->soort;
+        }
+    }
+    return 0;
+}
+
+bool unicode_naam_begin(uint32_t codepunt)
+{
+    return unicode_soort(codepunt) == UNICODE_NAAM_BEGIN;
+}
+
+bool unicode_naam(uint32_t codepunt)
+{
+    return unicode_soort(codepunt) != 0;
+}
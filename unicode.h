@@ -0,0 +1,16 @@
+#ifndef UNICODE_H
+#define UNICODE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Welke tekens buiten ASCII in een naam mogen staan (XID_Start en
+ * XID_Continue). De lexer vraagt dit alleen voor bytes vanaf 0x80; ASCII
+ * gaat via scan_klassen.
+ */
+
+bool unicode_naam_begin(uint32_t codepunt);
+bool unicode_naam(uint32_t codepunt);
+
+#endif
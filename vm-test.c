@@ -26,7 +26,7 @@ int main()
     size_t mem_size = sizeof(mem);
     vm_state state;
 
-    vm_init(&state, mem, mem_size);
+    vm_init(&state, mem, mem_size, NULL);
 
     VM_ERR err = VM_ERR_NONE;
     while (err == VM_ERR_NONE) {
@@ -50,4 +50,6 @@ int main()
             printf("VM_ERR_ILLEGAL_INST\n");
             break;
     }
+
+    vm_free(&state);
 }
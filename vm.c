@@ -2,18 +2,18 @@
 #include <stdint.h>
 #include <stdlib.h>
 
-static void stack_init(vm_stack_t *s)
+static void stack_init(vm_stack_t *s, GEHEUGEN *geheugen)
 {
     s->size = 0;
     s->allocated = sizeof(uint32_t) * 128;
-    s->stack = malloc(sizeof(uint32_t) * s->allocated);
+    s->stack = geheugen_alloc(geheugen, GEHEUGEN_VM, s->allocated);
 }
 
 static void stack_push(vm_stack_t *s, uint32_t v)
 {
     if (s->size * sizeof(uint32_t) >= s->allocated) {
         s->allocated += sizeof(uint32_t) * 128;
-        s->stack = realloc(s->stack, s->allocated);
+        s->stack = geheugen_realloc(NULL, GEHEUGEN_VM, s->stack, s->allocated);
     }
     s->stack[s->size] = v;
     s->size++;
@@ -41,7 +41,7 @@ static uint32_t stack_get(vm_stack_t *s, uint32_t offset)
     return s->stack[s->size-(1+offset)];
 }
 
-void vm_init(vm_state *s, uint8_t *mem, uint32_t mem_size)
+void vm_init(vm_state *s, uint8_t *mem, uint32_t mem_size, GEHEUGEN *geheugen)
 {
     for (unsigned int i = 0; i < REGISTER_COUNT; i++) {
         s->regs[i] = 0;
@@ -53,8 +53,16 @@ void vm_init(vm_state *s, uint8_t *mem, uint32_t mem_size)
     s->mem = mem;
     s->mem_size = mem_size;
 
-    stack_init(&s->call_stack);
-    stack_init(&s->variable_stack);
+    stack_init(&s->call_stack, geheugen);
+    stack_init(&s->variable_stack, geheugen);
+}
+
+void vm_free(vm_state *s)
+{
+    geheugen_vrij(s->call_stack.stack);
+    geheugen_vrij(s->variable_stack.stack);
+    s->call_stack.stack = NULL;
+    s->variable_stack.stack = NULL;
 }
 
 VM_ERR vm_step(vm_state *s)
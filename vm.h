@@ -1,5 +1,6 @@
 #ifndef VM_H
 #define VM_H
+#include "geheugen.h"
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -70,7 +71,9 @@ typedef struct {
     uint8_t exit_code;
 } vm_state;
 
-void vm_init(vm_state *s, uint8_t *mem, uint32_t mem_size);
+// the stacks are allocated from geheugen (NULL: geheugen_standaard)
+void vm_init(vm_state *s, uint8_t *mem, uint32_t mem_size, GEHEUGEN *geheugen);
+void vm_free(vm_state *s);
 VM_ERR vm_step(vm_state *s);
 
 #endif